@@ -0,0 +1,91 @@
+#if !defined(__ACCUMULATORS__)
+#define __ACCUMULATORS__
+
+#include <cstddef>
+#include <limits>
+#include "ds/span.hpp"
+
+namespace ds {
+
+// ────────────────────────────────────────────────
+// Streaming (online) accumulators
+// ────────────────────────────────────────────────
+//
+// Single-pass, O(1)-memory summaries that can be fed one value or one
+// chunk at a time and merged, so data never has to fit in memory and each
+// thread can summarize its own part before the results are combined.
+//
+// Single values use Welford's update. A chunk is summarized exactly (two
+// passes over a cache-sized block, so the data is still read from memory
+// only once) and folded in with the pairwise merge of Chan, Golub &
+// LeVeque, which is also what merge() does. Both keep the sum of squared
+// deviations from the running mean rather than a raw sum of squares, so
+// there is no catastrophic cancellation.
+
+/// Count, mean, variance, min and max of a stream of values
+class RunningStats {
+public:
+    /// Add one value
+    void push(double x);
+
+    /// Add a chunk of values
+    void push(ConstVectorSpan xs);
+
+    /// Fold in the summary of another (disjoint) part of the data
+    void merge(const RunningStats& other);
+
+    size_t count() const noexcept { return count_; }
+    double mean() const noexcept { return mean_; }
+    double min() const noexcept { return min_; }
+    double max() const noexcept { return max_; }
+
+    /// @return Sample variance (divides by count - 1); needs count >= 2
+    double variance() const;
+
+    /// @return Sample standard deviation; needs count >= 2
+    double standard_deviation() const;
+
+private:
+    size_t count_ = 0;
+    double mean_ = 0.0;
+    double m2_ = 0.0;     // sum of squared deviations from mean_
+    double min_ = std::numeric_limits<double>::infinity();
+    double max_ = -std::numeric_limits<double>::infinity();
+};
+
+/// Means, variances, covariance and correlation of a stream of (x, y) pairs
+class RunningCovariance {
+public:
+    /// Add one pair
+    void push(double x, double y);
+
+    /// Add a chunk of pairs
+    void push(ConstVectorSpan xs, ConstVectorSpan ys);
+
+    /// Fold in the summary of another (disjoint) part of the data
+    void merge(const RunningCovariance& other);
+
+    size_t count() const noexcept { return count_; }
+    double mean_x() const noexcept { return mean_x_; }
+    double mean_y() const noexcept { return mean_y_; }
+
+    /// Sample statistics (divide by count - 1); need count >= 2
+    double variance_x() const;
+    double variance_y() const;
+    double covariance() const;
+
+    /// @return Pearson correlation, or 0 if either variable is constant
+    double correlation() const;
+
+private:
+    size_t count_ = 0;
+    double mean_x_ = 0.0;
+    double mean_y_ = 0.0;
+    double m2_x_ = 0.0;   // sum of squared deviations of x
+    double m2_y_ = 0.0;   // sum of squared deviations of y
+    double c_xy_ = 0.0;   // sum of products of deviations
+};
+
+} // namespace ds
+
+#endif // __ACCUMULATORS__
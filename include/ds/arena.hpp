@@ -0,0 +1,101 @@
+#if !defined(__ARENA__)
+#define __ARENA__
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace ds {
+
+// ────────────────────────────────────────────────
+// Arena (bump) allocation for short-lived temporaries
+// ────────────────────────────────────────────────
+//
+// An Arena hands out memory by bumping a pointer through large blocks and
+// never frees individual allocations; reset() or rewind() make the whole
+// region reusable at once while keeping the blocks. It is a
+// std::pmr::memory_resource, so any pmr container can live in it.
+//
+// Every thread has its own scratch arena (scratch_arena()). The library
+// takes its internal temporaries from it inside a ScratchScope, which
+// rewinds on exit, so steady-state hot loops do no heap allocation and no
+// allocator locking. Callers may use the same arena for their own
+// per-iteration temporaries and call scratch_arena().reset() once per
+// iteration, outside any ScratchScope.
+
+class Arena : public std::pmr::memory_resource {
+public:
+    /// Position in the arena, used to free everything allocated after it
+    struct Mark {
+        size_t block;
+        size_t offset;
+    };
+
+    /// @param block_size Size of each block requested from the heap
+    explicit Arena(size_t block_size = 64 * 1024);
+    ~Arena() override;
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /// @return The current position
+    Mark mark() const { return {current_, offset_}; }
+
+    /// Release everything allocated after `m`; the memory is kept for reuse
+    void rewind(Mark m);
+
+    /// Release everything; the memory is kept for reuse
+    void reset() { rewind({0, 0}); }
+
+    /// @return Total bytes obtained from the heap so far
+    size_t bytes_reserved() const;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}   // freed by rewind/reset
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    struct Block {
+        std::byte* data;
+        size_t size;
+    };
+
+    size_t block_size_;
+    std::vector<Block> blocks_;
+    size_t current_ = 0;   // index of the block being bumped
+    size_t offset_ = 0;    // bytes used in that block
+};
+
+/// @return This thread's scratch arena
+Arena& scratch_arena();
+
+/// RAII guard: everything allocated from scratch_arena() during the scope
+/// is released when it ends. Scopes nest.
+class ScratchScope {
+public:
+    ScratchScope() : arena_(scratch_arena()), mark_(arena_.mark()) {}
+    ~ScratchScope() { arena_.rewind(mark_); }
+
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+    Arena& arena() const { return arena_; }
+
+private:
+    Arena& arena_;
+    Arena::Mark mark_;
+};
+
+/// A vector of doubles allocated from an arena (or any pmr resource)
+using ScratchVector = std::pmr::vector<double>;
+
+/// @return A zero-filled ScratchVector of size n in this thread's scratch arena
+inline ScratchVector make_scratch(size_t n) {
+    return ScratchVector(n, 0.0, &scratch_arena());
+}
+
+} // namespace ds
+
+#endif // __ARENA__
@@ -0,0 +1,73 @@
+#if !defined(__BOOTSTRAP__)
+#define __BOOTSTRAP__
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "ds/linear_algebra.hpp"
+
+namespace ds {
+
+// ────────────────────────────────────────────────
+// Bootstrap confidence intervals
+// ────────────────────────────────────────────────
+//
+// A resample is never materialized: it is described by how often each of
+// the n observations was drawn (counts summing to n), and statistics are
+// evaluated as frequency-weighted sums over the original data. Order
+// statistics sort the data once up front and then find their rank by
+// walking the cumulative counts, so no resample is copied or sorted.
+//
+// Resamples run in parallel on the thread pool. Resample r draws from its
+// own random stream, seeded from (seed, r), so the replicates are the same
+// whatever the thread count or scheduling.
+
+/// How often each observation appears in one resample
+using ResampleCounts = Span<const uint32_t>;
+
+/// A statistic of a resample given as counts of the original
+/// observations. Called concurrently from several threads.
+using ResampleStatistic = std::function<double(ResampleCounts counts)>;
+
+enum class IntervalMethod {
+    Percentile,   // quantiles of the bootstrap distribution
+    BCa,          // bias-corrected and accelerated (Efron, 1987)
+};
+
+struct BootstrapOptions {
+    size_t resamples = 10000;
+    double confidence = 0.95;
+    IntervalMethod method = IntervalMethod::Percentile;
+    uint64_t seed = 0x5eed;
+
+    /// BCa acceleration comes from a delete-a-group jackknife with this
+    /// many interleaved groups (a leave-one-out jackknife when >= n), which
+    /// keeps its cost at a few full passes for any n
+    size_t jackknife_groups = 100;
+};
+
+struct ConfidenceInterval {
+    double estimate;   // the statistic of the original sample
+    double lower;
+    double upper;
+};
+
+/// @param n Number of observations (< 2^32)
+/// @param statistic Evaluated on every resample
+/// @return The statistic of every resample, in resample order
+Vector bootstrap_replicates(size_t n, const ResampleStatistic& statistic,
+                            const BootstrapOptions& options = {});
+
+/// Confidence interval for any statistic expressed over resample counts
+ConfidenceInterval bootstrap(size_t n, const ResampleStatistic& statistic,
+                             const BootstrapOptions& options = {});
+
+ConfidenceInterval bootstrap_mean(ConstVectorSpan xs, const BootstrapOptions& options = {});
+ConfidenceInterval bootstrap_median(ConstVectorSpan xs, const BootstrapOptions& options = {});
+ConfidenceInterval bootstrap_standard_deviation(ConstVectorSpan xs, const BootstrapOptions& options = {});
+ConfidenceInterval bootstrap_correlation(ConstVectorSpan xs, ConstVectorSpan ys,
+                                         const BootstrapOptions& options = {});
+
+} // namespace ds
+
+#endif // __BOOTSTRAP__
@@ -0,0 +1,130 @@
+#if !defined(__COLUMNAR__)
+#define __COLUMNAR__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ds/span.hpp"
+
+namespace ds {
+
+// ────────────────────────────────────────────────
+// Columnar binary files
+// ────────────────────────────────────────────────
+//
+// A table stored column by column so it can be memory-mapped and handed to
+// the statistics and linear algebra functions as spans, with no parsing
+// and no copy. Pages are read from disk (or the page cache) on first use.
+//
+// Layout (native byte order, every section 64-byte aligned):
+//
+//   header      magic "DSCOL\0\0\1", version, column count, row count,
+//               rows per chunk
+//   directory   per column: name offset/length, type, data offset,
+//               chunk-statistics offset (0 if none)
+//   names       the column names, back to back
+//   data        per column: rows values of its type
+//   statistics  per column (optional): one ChunkStats per chunk of
+//               chunk_rows rows, so summaries and filters can skip data
+
+/// Element type of a column
+enum class ColumnType : uint32_t {
+    Float64 = 0,
+    Float32 = 1,
+};
+
+/// Metadata of one chunk of a column
+struct ChunkStats {
+    double min;
+    double max;
+    double sum;
+};
+
+/// Collects columns and writes them as one columnar file
+class ColumnarWriter {
+public:
+    /// @param chunk_rows Rows per chunk of the per-chunk statistics
+    /// @param chunk_stats Whether to store per-chunk min/max/sum
+    explicit ColumnarWriter(size_t chunk_rows = 65536, bool chunk_stats = true);
+
+    /// Add a column; the data is not copied and must stay alive until
+    /// write(). All columns must have the same length.
+    void add_column(const std::string& name, ConstVectorSpan values);
+    void add_column(const std::string& name, ConstFloatSpan values);
+
+    /// Write the file
+    /// @throws std::runtime_error if the file cannot be written
+    void write(const std::string& path) const;
+
+private:
+    struct Column {
+        std::string name;
+        ColumnType type;
+        const void* data;
+    };
+
+    size_t chunk_rows_;
+    bool chunk_stats_;
+    size_t rows_ = 0;
+    std::vector<Column> columns_;
+};
+
+/// A columnar file mapped read-only into memory
+class ColumnarFile {
+public:
+    /// Map a file written by ColumnarWriter
+    /// @throws std::runtime_error if it cannot be opened or is not a valid
+    ///         columnar file
+    explicit ColumnarFile(const std::string& path);
+    ~ColumnarFile();
+
+    ColumnarFile(ColumnarFile&& other) noexcept;
+    ColumnarFile& operator=(ColumnarFile&& other) noexcept;
+    ColumnarFile(const ColumnarFile&) = delete;
+    ColumnarFile& operator=(const ColumnarFile&) = delete;
+
+    size_t rows() const noexcept { return rows_; }
+    size_t num_columns() const noexcept { return columns_.size(); }
+    size_t chunk_rows() const noexcept { return chunk_rows_; }
+    size_t num_chunks() const noexcept { return (rows_ + chunk_rows_ - 1) / chunk_rows_; }
+
+    const std::string& name(size_t c) const { return columns_[c].name; }
+    ColumnType type(size_t c) const { return columns_[c].type; }
+
+    /// @return Index of the column called name, or num_columns() if none
+    size_t find(const std::string& name) const;
+
+    /// Zero-copy view of a Float64 column (valid while the file is open)
+    /// @throws std::runtime_error if column c is not Float64
+    ConstVectorSpan column(size_t c) const;
+
+    /// Zero-copy view of a Float32 column
+    /// @throws std::runtime_error if column c is not Float32
+    ConstFloatSpan float_column(size_t c) const;
+
+    /// @return One entry per chunk, or an empty span if the file has no
+    ///         chunk statistics
+    Span<const ChunkStats> chunk_stats(size_t c) const;
+
+private:
+    struct Column {
+        std::string name;
+        ColumnType type;
+        const unsigned char* data;
+        const ChunkStats* stats;
+    };
+
+    void release() noexcept;
+
+    const unsigned char* base_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;                 // false: base_ owns a heap copy
+    size_t rows_ = 0;
+    size_t chunk_rows_ = 1;
+    std::vector<Column> columns_;
+};
+
+} // namespace ds
+
+#endif // __COLUMNAR__
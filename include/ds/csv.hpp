@@ -0,0 +1,86 @@
+#if !defined(__CSV__)
+#define __CSV__
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ds/linear_algebra.hpp"
+
+namespace ds {
+
+// ────────────────────────────────────────────────
+// CSV ingestion
+// ────────────────────────────────────────────────
+//
+// Numeric CSV straight into column Vectors. A block of text is cut into
+// one piece per thread at record boundaries (the first newline after an
+// even split), the records of every piece are counted in parallel, the
+// columns are allocated once at their final size, and each piece then
+// parses its fields with std::from_chars directly into its rows. No
+// string is built per field.
+//
+// Fields are numbers as accepted by std::from_chars (plus an optional
+// leading '+' and surrounding spaces); an empty field is NaN. Quoted
+// fields are not supported. Lines may end in "\n" or "\r\n"; blank lines
+// are skipped.
+
+struct CsvOptions {
+    char delimiter = ',';
+    bool header = true;                  // first record holds column names
+    size_t chunk_bytes = size_t(1) << 24;   // CsvReader: bytes read per chunk
+};
+
+/// A parsed table: one Vector per column
+struct CsvTable {
+    std::vector<std::string> names;      // "0", "1", ... without a header
+    std::vector<Vector> columns;
+
+    size_t rows() const { return columns.empty() ? 0 : columns[0].size(); }
+};
+
+/// Parse CSV text held in memory
+/// @throws std::runtime_error on a malformed record
+CsvTable parse_csv(std::string_view text, const CsvOptions& options = {});
+
+/// Read and parse a whole CSV file
+/// @throws std::runtime_error if the file cannot be read or is malformed
+CsvTable read_csv(const std::string& path, const CsvOptions& options = {});
+
+/// Reads a CSV file a chunk of records at a time, e.g. to feed the
+/// streaming accumulators without holding the whole file:
+///
+///     CsvReader reader("metrics.csv");
+///     std::vector<RunningStats> stats(reader.names().size());
+///     std::vector<Vector> chunk;
+///     while (reader.next(chunk))
+///         for (size_t c = 0; c < chunk.size(); ++c) stats[c].push(chunk[c]);
+class CsvReader {
+public:
+    /// Opens the file and reads the header (or the first record's width)
+    /// @throws std::runtime_error if the file cannot be opened
+    explicit CsvReader(const std::string& path, const CsvOptions& options = {});
+
+    const std::vector<std::string>& names() const noexcept { return names_; }
+
+    /// Parse the next chunk (about options.chunk_bytes of text)
+    /// @param columns Resized to one Vector per column holding the chunk's
+    ///        rows; the storage is reused from call to call
+    /// @return false when the file is exhausted
+    /// @throws std::runtime_error on a malformed record
+    bool next(std::vector<Vector>& columns);
+
+private:
+    bool fill();   // read more text into buffer_; false at end of file
+
+    std::ifstream in_;
+    CsvOptions options_;
+    std::vector<std::string> names_;
+    std::string buffer_;      // unparsed text, starting at a record boundary
+    size_t rows_read_ = 0;    // records parsed so far (for error messages)
+};
+
+} // namespace ds
+
+#endif // __CSV__
@@ -0,0 +1,160 @@
+#if !defined(__DENSE_MATRIX__)
+#define __DENSE_MATRIX__
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <vector>
+#include "ds/span.hpp"
+
+namespace ds {
+
+// ────────────────────────────────────────────────
+// Aligned storage
+// ────────────────────────────────────────────────
+
+/// Cache-line alignment used for all dense buffers
+constexpr size_t kDefaultAlignment = 64;
+
+/// Minimal allocator returning `Alignment`-aligned memory
+template<typename T, size_t Alignment = kDefaultAlignment>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template<typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() noexcept = default;
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* p, size_t) noexcept {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+template<typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+// ────────────────────────────────────────────────
+// Matrix views
+// ────────────────────────────────────────────────
+
+/// A non-owning row-major view of `rows() x cols()` elements whose rows
+/// start `stride()` elements apart.
+/// @tparam T Element type; use `const double` for read-only views
+template<typename T>
+class BasicMatrixView {
+public:
+    constexpr BasicMatrixView() noexcept = default;
+    constexpr BasicMatrixView(T* data, size_t rows, size_t cols, size_t stride) noexcept
+        : data_(data), rows_(rows), cols_(cols), stride_(stride) {}
+
+    template<typename U,
+             typename = std::enable_if_t<!std::is_same<U, T>::value &&
+                                         std::is_convertible<U (*)[], T (*)[]>::value>>
+    constexpr BasicMatrixView(const BasicMatrixView<U>& other) noexcept
+        : data_(other.data()), rows_(other.rows()), cols_(other.cols()), stride_(other.stride()) {}
+
+    constexpr T* data() const noexcept { return data_; }
+    constexpr size_t rows() const noexcept { return rows_; }
+    constexpr size_t cols() const noexcept { return cols_; }
+    constexpr size_t stride() const noexcept { return stride_; }
+
+    T& operator()(size_t i, size_t j) const {
+        assert(i < rows_ && j < cols_);
+        return data_[i * stride_ + j];
+    }
+
+    Span<T> row(size_t i) const {
+        assert(i < rows_);
+        return Span<T>(data_ + i * stride_, cols_);
+    }
+
+    StridedSpan<T> column(size_t j) const {
+        assert(j < cols_);
+        return StridedSpan<T>(data_ + j, rows_, stride_);
+    }
+
+    /// @return The view of rows [i, i + r) and columns [j, j + c)
+    BasicMatrixView block(size_t i, size_t j, size_t r, size_t c) const {
+        assert(i + r <= rows_ && j + c <= cols_);
+        return BasicMatrixView(data_ + i * stride_ + j, r, c, stride_);
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    size_t stride_ = 0;
+};
+
+using MatrixView      = BasicMatrixView<double>;
+using ConstMatrixView = BasicMatrixView<const double>;
+
+// ────────────────────────────────────────────────
+// Dense row-major matrix
+// ────────────────────────────────────────────────
+
+/// A row-major matrix stored in one contiguous, 64-byte aligned buffer.
+/// Rows are packed back to back (stride == cols), so a full pass over the
+/// data is a single linear sweep and rows/columns/blocks are cheap views.
+class DenseMatrix {
+public:
+    DenseMatrix() = default;
+
+    /// @param rows Number of rows
+    /// @param cols Number of columns
+    /// @param value Initial value of every entry (default 0)
+    DenseMatrix(size_t rows, size_t cols, double value = 0.0)
+        : rows_(rows), cols_(cols), data_(rows * cols, value) {}
+
+    size_t rows() const noexcept { return rows_; }
+    size_t cols() const noexcept { return cols_; }
+    size_t stride() const noexcept { return cols_; }
+    size_t size() const noexcept { return data_.size(); }
+
+    double* data() noexcept { return data_.data(); }
+    const double* data() const noexcept { return data_.data(); }
+
+    double& operator()(size_t i, size_t j) {
+        assert(i < rows_ && j < cols_);
+        return data_[i * cols_ + j];
+    }
+    double operator()(size_t i, size_t j) const {
+        assert(i < rows_ && j < cols_);
+        return data_[i * cols_ + j];
+    }
+
+    VectorSpan row(size_t i) { return view().row(i); }
+    ConstVectorSpan row(size_t i) const { return view().row(i); }
+
+    StridedVectorSpan column(size_t j) { return view().column(j); }
+    ConstStridedSpan column(size_t j) const { return view().column(j); }
+
+    MatrixView block(size_t i, size_t j, size_t r, size_t c) { return view().block(i, j, r, c); }
+    ConstMatrixView block(size_t i, size_t j, size_t r, size_t c) const { return view().block(i, j, r, c); }
+
+    MatrixView view() noexcept { return MatrixView(data(), rows_, cols_, cols_); }
+    ConstMatrixView view() const noexcept { return ConstMatrixView(data(), rows_, cols_, cols_); }
+
+    operator MatrixView() noexcept { return view(); }
+    operator ConstMatrixView() const noexcept { return view(); }
+
+private:
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    AlignedVector<double> data_;
+};
+
+} // namespace ds
+
+#endif // __DENSE_MATRIX__
@@ -0,0 +1,60 @@
+#if !defined(__DESCRIBE__)
+#define __DESCRIBE__
+
+#include <cstddef>
+#include <vector>
+#include "ds/dense_matrix.hpp"
+#include "ds/linear_algebra.hpp"
+
+namespace ds {
+
+// ────────────────────────────────────────────────
+// Table summaries
+// ────────────────────────────────────────────────
+//
+// describe() replaces calling mean, standard_deviation, data_range,
+// quantile, ... per column: every column is read once, and the moments,
+// extremes and quantile sketch are all fed from the same cache-sized block
+// (RunningStats and QuantileSketch). Columns are split into chunks that
+// are summarized in parallel and merged, so both wide and long tables use
+// every thread.
+
+/// Summary of one column (fields that need more data are NaN)
+struct ColumnSummary {
+    size_t count = 0;
+    double mean;
+    double variance;             // sample variance, needs count >= 2
+    double standard_deviation;
+    double min;
+    double max;
+    Vector quantiles;            // at DescribeOptions::percentiles
+};
+
+struct DescribeOptions {
+    /// Quantiles to report, fractions in [0, 1]
+    Vector percentiles{0.25, 0.5, 0.75};
+
+    /// true: exact quantiles (a selection over a copy of each column, so a
+    /// second pass); false: one pass with a QuantileSketch per chunk
+    bool exact_quantiles = false;
+
+    /// Accuracy of the sketch when exact_quantiles is false
+    size_t sketch_k = 200;
+};
+
+/// @param columns One span per column (columns may differ in length)
+/// @return One summary per column
+std::vector<ColumnSummary> describe(const std::vector<ConstVectorSpan>& columns,
+                                    const DescribeOptions& options = {});
+
+/// @param columns Each inner vector is one column
+std::vector<ColumnSummary> describe(const std::vector<Vector>& columns,
+                                    const DescribeOptions& options = {});
+
+/// @param table Row-major table, one summary per column
+std::vector<ColumnSummary> describe(ConstMatrixView table,
+                                    const DescribeOptions& options = {});
+
+} // namespace ds
+
+#endif // __DESCRIBE__
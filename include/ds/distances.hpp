@@ -0,0 +1,58 @@
+#if !defined(__DISTANCES__)
+#define __DISTANCES__
+
+#include <cstddef>
+#include <vector>
+#include "ds/linear_algebra.hpp"
+
+namespace ds {
+
+// ────────────────────────────────────────────────
+// Batched pairwise distances
+// ────────────────────────────────────────────────
+//
+// Points are the rows of A (n x d) and B (m x d). Distances use the
+// expansion ||a - b||^2 = ||a||^2 + ||b||^2 - 2 a.b, so the bulk of the
+// work is one blocked GEMM. The expansion cancels when two points are
+// much closer to each other than to the origin: results are clamped at 0
+// and carry an absolute error of roughly eps * (||a||^2 + ||b||^2).
+// Center the data first if that matters; use squared_distance() when an
+// exact value for a single pair is required.
+
+/// A neighbour of a query point
+struct Neighbor {
+    size_t index;             // row of B
+    double squared_distance;
+};
+
+/// Squared norm of every row
+/// @param A Matrix whose rows are points
+/// @return Vector of ||A_i||^2
+Vector row_squared_norms(ConstMatrixView A);
+
+/// All squared distances between rows of A and rows of B
+/// @param A Query points (n x d)
+/// @param B Reference points (m x d)
+/// @param D Output (n x m), D(i, j) = ||A_i - B_j||^2
+void pairwise_squared_distances(ConstMatrixView A, ConstMatrixView B, MatrixView D);
+
+/// @return n x m matrix of squared distances between rows of A and B
+DenseMatrix pairwise_squared_distances(const DenseMatrix& A, const DenseMatrix& B);
+
+/// @return Squared distances between two lists of points (nested storage)
+Matrix pairwise_squared_distances(const Matrix& A, const Matrix& B);
+
+/// Streaming top-k: the k nearest rows of B for every row of A, computed
+/// tile by tile so the full n x m distance matrix is never materialized
+/// (memory is O(n * k) plus one tile per thread).
+/// @param A Query points (n x d)
+/// @param B Reference points (m x d)
+/// @param k Neighbours per query (clamped to m)
+/// @return For each query, its neighbours sorted by distance (ties by index);
+///         pairs whose distance is NaN are left out, so a list can be shorter
+///         than k
+std::vector<std::vector<Neighbor>> pairwise_top_k(ConstMatrixView A, ConstMatrixView B, size_t k);
+
+} // namespace ds
+
+#endif // __DISTANCES__
@@ -0,0 +1,133 @@
+#if !defined(__FIXED_VECTOR__)
+#define __FIXED_VECTOR__
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include "ds/span.hpp"
+
+namespace ds {
+
+// ────────────────────────────────────────────────
+// Compile-time sized vectors
+// ────────────────────────────────────────────────
+//
+// FixedVector<N> stores its N doubles inline (no heap) and every operation
+// below is expanded over std::index_sequence, so the loops are unrolled at
+// compile time and small vectors live entirely in registers. Everything
+// except magnitude/distance (which need std::sqrt) is constexpr.
+
+template<size_t N>
+struct FixedVector {
+    static_assert(N > 0, "FixedVector needs at least one element");
+
+    double v[N];
+
+    static constexpr size_t size() noexcept { return N; }
+
+    constexpr double& operator[](size_t i) { return v[i]; }
+    constexpr const double& operator[](size_t i) const { return v[i]; }
+
+    constexpr double* data() noexcept { return v; }
+    constexpr const double* data() const noexcept { return v; }
+
+    constexpr double* begin() noexcept { return v; }
+    constexpr double* end() noexcept { return v + N; }
+    constexpr const double* begin() const noexcept { return v; }
+    constexpr const double* end() const noexcept { return v + N; }
+
+    /// Views for the span-based (in-place, SIMD) API
+    operator VectorSpan() noexcept { return VectorSpan(v, N); }
+    operator ConstVectorSpan() const noexcept { return ConstVectorSpan(v, N); }
+};
+
+namespace fixed_detail {
+
+template<size_t N, typename F, size_t... I>
+constexpr FixedVector<N> generate(F f, std::index_sequence<I...>) {
+    return FixedVector<N>{{f(I)...}};
+}
+
+template<typename F, size_t... I>
+constexpr double sum(F f, std::index_sequence<I...>) {
+    return (0.0 + ... + f(I));
+}
+
+template<typename F, size_t... I>
+constexpr bool all(F f, std::index_sequence<I...>) {
+    return (true && ... && f(I));
+}
+
+} // namespace fixed_detail
+
+/// @return FixedVector<N> whose i-th entry is f(i)
+template<size_t N, typename F>
+constexpr FixedVector<N> make_fixed(F f) {
+    return fixed_detail::generate<N>(f, std::make_index_sequence<N>{});
+}
+
+// Same names and meaning as the Vector functions in linear_algebra.hpp
+
+template<size_t N>
+constexpr FixedVector<N> add(const FixedVector<N>& v, const FixedVector<N>& w) {
+    return make_fixed<N>([&](size_t i) { return v[i] + w[i]; });
+}
+
+template<size_t N>
+constexpr FixedVector<N> subtract(const FixedVector<N>& v, const FixedVector<N>& w) {
+    return make_fixed<N>([&](size_t i) { return v[i] - w[i]; });
+}
+
+template<size_t N>
+constexpr FixedVector<N> scalar_multiply(double c, const FixedVector<N>& v) {
+    return make_fixed<N>([&](size_t i) { return c * v[i]; });
+}
+
+template<size_t N>
+constexpr double dot(const FixedVector<N>& v, const FixedVector<N>& w) {
+    return fixed_detail::sum([&](size_t i) { return v[i] * w[i]; }, std::make_index_sequence<N>{});
+}
+
+template<size_t N>
+constexpr double sum_of_squares(const FixedVector<N>& v) {
+    return dot(v, v);
+}
+
+template<size_t N>
+double magnitude(const FixedVector<N>& v) {
+    return std::sqrt(sum_of_squares(v));
+}
+
+template<size_t N>
+constexpr double squared_distance(const FixedVector<N>& v, const FixedVector<N>& w) {
+    return sum_of_squares(subtract(v, w));
+}
+
+template<size_t N>
+double distance(const FixedVector<N>& v, const FixedVector<N>& w) {
+    return std::sqrt(squared_distance(v, w));
+}
+
+template<size_t N>
+constexpr FixedVector<N> operator+(const FixedVector<N>& v, const FixedVector<N>& w) { return add(v, w); }
+
+template<size_t N>
+constexpr FixedVector<N> operator-(const FixedVector<N>& v, const FixedVector<N>& w) { return subtract(v, w); }
+
+template<size_t N>
+constexpr FixedVector<N> operator*(double c, const FixedVector<N>& v) { return scalar_multiply(c, v); }
+
+template<size_t N>
+constexpr FixedVector<N> operator*(const FixedVector<N>& v, double c) { return scalar_multiply(c, v); }
+
+template<size_t N>
+constexpr bool operator==(const FixedVector<N>& v, const FixedVector<N>& w) {
+    return fixed_detail::all([&](size_t i) { return v[i] == w[i]; }, std::make_index_sequence<N>{});
+}
+
+template<size_t N>
+constexpr bool operator!=(const FixedVector<N>& v, const FixedVector<N>& w) { return !(v == w); }
+
+} // namespace ds
+
+#endif // __FIXED_VECTOR__
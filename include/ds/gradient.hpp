@@ -5,6 +5,7 @@
 #include <functional>
 #include <utility>
 #include "ds/linear_algebra.hpp"
+#include "ds/sparse.hpp"
 
 namespace ds {
 
@@ -69,6 +70,15 @@ Vector gradient_step(
     const Vector& gradient,
     double step_size);
 
+/// Perform one step of gradient descent in place: v += step_size * gradient
+/// @param v The current point, overwritten with the updated point
+/// @param gradient The gradient at v
+/// @param step_size The step size (usually negative for descent)
+void gradient_step_inplace(
+    VectorSpan v,
+    ConstVectorSpan gradient,
+    double step_size);
+
 /// Compute the gradient of the sum of squares function
 /// @param v Input vector
 /// @return 2*v (analytical gradient of ||v||²)
@@ -85,6 +95,90 @@ Vector sum_of_squares_gradient(const Vector& v);
 /// @return Gradient vector with respect to [slope, intercept]
 Vector linear_gradient(double x, double y, const Vector& theta);
 
+/// Allocation-free linear_gradient: writes the gradient into caller-owned
+/// memory (a stack array, a matrix row or an arena-backed ScratchVector)
+/// @param x The input feature value
+/// @param y The actual target value
+/// @param theta The model parameters [slope, intercept]
+/// @param grad Output, receives [∂/∂slope, ∂/∂intercept]
+void linear_gradient_into(double x, double y, ConstVectorSpan theta, VectorSpan grad);
+
+// ────────────────────────────────────────────────
+// Fixed-size overloads (stack storage, unrolled, constexpr)
+// ────────────────────────────────────────────────
+
+/// Perform one step of gradient descent on a fixed-size parameter vector
+/// @param v The current point
+/// @param gradient The gradient at v
+/// @param step_size The step size (usually negative for descent)
+/// @return Updated point after one gradient step
+template<size_t N>
+constexpr FixedVector<N> gradient_step(
+    const FixedVector<N>& v,
+    const FixedVector<N>& gradient,
+    double step_size)
+{
+    return make_fixed<N>([&](size_t i) { return v[i] + step_size * gradient[i]; });
+}
+
+/// Compute the gradient of the sum of squares function
+/// @param v Input vector
+/// @return 2*v
+template<size_t N>
+constexpr FixedVector<N> sum_of_squares_gradient(const FixedVector<N>& v) {
+    return scalar_multiply(2.0, v);
+}
+
+/// Gradient of squared error for linear regression, without allocation
+/// @param x The input feature value
+/// @param y The actual target value
+/// @param theta The model parameters [slope, intercept]
+/// @return Gradient with respect to [slope, intercept]
+constexpr FixedVector<2> linear_gradient(double x, double y, const FixedVector<2>& theta) {
+    double error = (theta[0] * x + theta[1]) - y;
+    return FixedVector<2>{{2 * error * x, 2 * error}};
+}
+
+// ────────────────────────────────────────────────
+// Sparse features
+// ────────────────────────────────────────────────
+
+/// Gradient step with a sparse gradient: only the coordinates the gradient
+/// touches are updated
+/// @param v The current point, overwritten with the updated point
+/// @param gradient The (sparse) gradient at v
+/// @param step_size The step size (usually negative for descent)
+void gradient_step_inplace(
+    VectorSpan v,
+    SparseView gradient,
+    double step_size);
+
+/// Perform one step of gradient descent with a sparse gradient
+/// @param v The current point
+/// @param gradient The (sparse) gradient at v
+/// @param step_size The step size (usually negative for descent)
+/// @return Updated point after one gradient step
+Vector gradient_step(
+    const Vector& v,
+    const SparseVector& gradient,
+    double step_size);
+
+/// Gradient of the squared error (theta . x - y)^2 for one sparse example;
+/// it is non-zero only where x is, so it is returned sparse
+/// @param x The feature vector (include a constant 1 feature for an intercept)
+/// @param y The actual target value
+/// @param theta The model parameters, one per feature
+/// @return Gradient with respect to theta
+SparseVector linear_gradient(const SparseVector& x, double y, const Vector& theta);
+
+/// Mean-squared-error gradient over a whole sparse design matrix,
+/// (2 / n) X^T (X theta - y), without densifying X
+/// @param X The examples, one per row
+/// @param y The actual target values
+/// @param theta The model parameters, one per column of X
+/// @return Gradient with respect to theta
+Vector least_squares_gradient(const CsrMatrix& X, const Vector& y, const Vector& theta);
+
 // ────────────────────────────────────────────────
 // Minibatch helper
 // ────────────────────────────────────────────────
@@ -0,0 +1,103 @@
+#if !defined(__HISTOGRAM__)
+#define __HISTOGRAM__
+
+#include <cstddef>
+#include <cstdint>
+#include "ds/linear_algebra.hpp"
+#include "ds/parallel.hpp"
+
+namespace ds {
+
+// ────────────────────────────────────────────────
+// Histograms
+// ────────────────────────────────────────────────
+//
+// Bins are [e_i, e_i+1) except the last, which also holds the upper edge.
+// Values are binned a block at a time: the bin index of every value is
+// computed first without branches (a dispatched SIMD kernel for equal-width
+// and log-scale bins, a branch-free binary search for arbitrary edges),
+// then the counts are incremented. Values below or above the range and
+// NaNs are counted separately, never dropped silently.
+//
+// Histograms with the same edges merge, so data can be streamed in chunks
+// or split across threads; the execution::par overloads give every thread
+// private counts and add them up in a fixed order.
+
+class Histogram {
+public:
+    /// `bins` equal-width bins on [lo, hi]
+    static Histogram uniform(double lo, double hi, size_t bins);
+
+    /// `bins` bins of equal width in log(x) on [lo, hi], 0 < lo < hi
+    static Histogram log_scale(double lo, double hi, size_t bins);
+
+    /// Arbitrary bins from ascending edges (at least two)
+    static Histogram with_edges(Vector edges);
+
+    /// Equal-frequency bins: edges at the quantiles of `sample`, so every
+    /// bin holds about the same share of the sample
+    static Histogram quantile_bins(ConstVectorSpan sample, size_t bins);
+
+    /// Add one value
+    void add(double x, double weight = 1.0);
+
+    /// Add a chunk of values (each counts 1)
+    void add(ConstVectorSpan xs);
+
+    /// Add a chunk of weighted values
+    void add(ConstVectorSpan xs, ConstVectorSpan weights);
+
+    /// Multithreaded versions of add (per-thread counts, then merged)
+    void add(execution::parallel_policy, ConstVectorSpan xs);
+    void add(execution::parallel_policy, ConstVectorSpan xs, ConstVectorSpan weights);
+
+    /// Add the counts of a histogram with the same edges
+    void merge(const Histogram& other);
+
+    size_t bins() const noexcept { return edges_.size() - 1; }
+    const Vector& edges() const noexcept { return edges_; }
+
+    /// @return (Weighted) count of bin i
+    double count(size_t i) const { return slots_[i + 1]; }
+
+    /// @return Counts of all bins
+    Vector counts() const;
+
+    double underflow() const noexcept { return slots_.front(); }        // below the first edge
+    double overflow() const noexcept { return slots_[bins() + 1]; }     // above the last edge
+    double missing() const noexcept { return slots_.back(); }           // NaN
+
+    /// @return Total (weighted) count inside the range
+    double total() const;
+
+    /// @return Bin of x, or bins() if x is outside the range or NaN
+    size_t bin_of(double x) const;
+
+    /// @return Bin midpoints (geometric midpoints for log-scale bins)
+    Vector centers() const;
+
+    /// @return count / (total * width) per bin, an estimate of the
+    ///         probability density comparable with e.g. normal_pdf
+    Vector density() const;
+
+private:
+    enum class Kind { Uniform, Log, Edges };
+
+    Histogram(Kind kind, Vector edges);
+
+    // slot of every x: 0 underflow, 1..bins, bins + 1 overflow, bins + 2 NaN
+    void slots(const double* x, size_t n, uint32_t* out) const;
+    // move computed slots onto the side of edges_ each x really is on
+    void snap_to_edges(const double* x, size_t n, uint32_t* out) const;
+    void accumulate(ConstVectorSpan xs, const double* weights, Vector& slots) const;
+    void add_parallel(ConstVectorSpan xs, const double* weights);
+
+    Kind kind_;
+    Vector edges_;
+    double lo_, hi_, scale_;   // Uniform / Log: range and bins per unit (of log x for Log)
+    Vector slots_;             // counts per slot
+};
+
+} // namespace ds
+
+#endif // __HISTOGRAM__
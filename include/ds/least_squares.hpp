@@ -0,0 +1,79 @@
+#if !defined(__LEAST_SQUARES__)
+#define __LEAST_SQUARES__
+
+#include <cstddef>
+#include "ds/linear_algebra.hpp"
+
+namespace ds {
+
+// ────────────────────────────────────────────────
+// Direct least-squares solvers
+// ────────────────────────────────────────────────
+//
+// Closed-form alternatives to iterating linear_gradient / gradient_step:
+// minimize ||A X - B|| for an m x n design matrix A (m >= n) and any
+// number of right-hand sides (the columns of B).
+//
+//   * Normal equations: A^T A X = A^T B solved by Cholesky. Fastest (the
+//     Gram matrix is one GEMM), but squares the condition number of A.
+//   * Householder QR: A = Q R, then R X = Q^T B. About twice the work and
+//     numerically robust; the default for least_squares().
+//
+// Both factorizations are blocked: a 64-column panel is factored and its
+// effect is then applied to the rest of the matrix with multithreaded
+// GEMMs (A22 -= L21 L21^T for Cholesky, the compact WY block reflector
+// I - V T V^T for QR).
+
+/// Cholesky factorization A = L L^T in place (blocked, right-looking)
+/// @param A Symmetric n x n matrix; only the lower triangle is read. On
+///          success it holds L, with the strict upper triangle zeroed.
+/// @return false if A is not (numerically) positive definite
+bool cholesky(MatrixView A);
+
+/// Solve L L^T X = B in place for every column of B
+/// @param L Lower-triangular factor from cholesky()
+/// @param B n x k right-hand sides, overwritten with X
+void cholesky_solve(ConstMatrixView L, MatrixView B);
+
+/// Householder QR factorization in place (blocked)
+/// @param A m x n matrix, m >= n. On return R is on and above the
+///          diagonal and the Householder vectors (with implicit leading 1)
+///          below it.
+/// @param tau Output, n reflector coefficients
+void householder_qr(MatrixView A, VectorSpan tau);
+
+/// B = Q^T B using the reflectors stored by householder_qr()
+/// @param QR Factorized m x n matrix
+/// @param tau Reflector coefficients
+/// @param B m x k matrix, overwritten
+void apply_qt(ConstMatrixView QR, ConstVectorSpan tau, MatrixView B);
+
+/// Least squares through the normal equations; falls back to QR when
+/// A^T A is not positive definite (e.g. collinear columns)
+/// @param A m x n design matrix
+/// @param B m x k right-hand sides
+/// @return n x k solution
+DenseMatrix least_squares_cholesky(ConstMatrixView A, ConstMatrixView B);
+
+/// Least squares through Householder QR. A must have full column rank;
+/// otherwise the result contains non-finite values.
+/// @param A m x n design matrix
+/// @param B m x k right-hand sides
+/// @return n x k solution
+DenseMatrix least_squares_qr(ConstMatrixView A, ConstMatrixView B);
+
+/// @param A m x n design matrix
+/// @param y m targets
+/// @return The n coefficients minimizing ||A beta - y|| (QR)
+Vector least_squares(ConstMatrixView A, const Vector& y);
+
+/// Closed-form simple linear regression
+/// @param x The input feature values
+/// @param y The actual target values
+/// @return [slope, intercept], the same layout as the theta used by
+///         linear_gradient()
+Vector least_squares_fit(const Vector& x, const Vector& y);
+
+} // namespace ds
+
+#endif // __LEAST_SQUARES__
@@ -3,39 +3,174 @@
 #include <vector>
 #include <utility>
 #include <functional>
-
+#include "ds/dense_matrix.hpp"
+#include "ds/parallel.hpp"
+#include "ds/fixed_vector.hpp"
+#include "ds/vector_expr.hpp"
 
 namespace ds
 {
 
-using Vector = std::vector<double>;
+template<typename T>
+using BasicVector = std::vector<T>;
+
+using Vector = BasicVector<double>;
+using FloatVector = BasicVector<float>;   // half the memory traffic of Vector
 using Matrix = std::vector<std::vector<double>>;
 
 // Vector operations
 Vector add(const Vector& v, const Vector& w);
 Vector subtract(const Vector& v, const Vector& w);
 Vector scalar_multiply(double c, const Vector& v);
+// vector_sum / vector_mean split the vectors across threads and use Kahan-
+// compensated accumulation (error independent of the number of vectors).
+// Results are bitwise reproducible for a fixed num_threads().
 Vector vector_sum(const std::vector<Vector>& vectors);
 Vector vector_mean(const std::vector<Vector>& vectors);
+Vector vector_sum(ConstMatrixView rows);    // sum of the rows
+Vector vector_mean(ConstMatrixView rows);
 double dot(const Vector& v, const Vector& w);
+double dot(ConstVectorSpan v, ConstVectorSpan w);         // any contiguous storage
 double sum_of_squares(const Vector& v);
+double sum_of_squares(ConstVectorSpan v);
 double magnitude(const Vector& v);
 double squared_distance(const Vector& v, const Vector& w);
 double distance(const Vector& v, const Vector& w);
 
+// In-place / output-parameter vector operations (BLAS-1 style). They work
+// on caller-owned memory and never allocate; `out` may be the same vector
+// as an input.
+void axpy(double a, ConstVectorSpan x, VectorSpan y);                       // y += a * x
+void scal(double a, VectorSpan x);                                          // x *= a
+void add_into(VectorSpan out, ConstVectorSpan v, ConstVectorSpan w);        // out = v + w
+void subtract_into(VectorSpan out, ConstVectorSpan v, ConstVectorSpan w);   // out = v - w
+void scale_into(VectorSpan out, double c, ConstVectorSpan v);               // out = c * v
+void accumulate(VectorSpan acc, ConstVectorSpan v);                         // acc += v
+
+// Single precision. Storage and elementwise results are float; reductions
+// widen each element to double and accumulate in double (mixed precision),
+// so they return double and lose no accuracy to the float accumulator.
+FloatVector to_float(ConstVectorSpan v);
+Vector to_double(ConstFloatSpan v);
+FloatVector add(const FloatVector& v, const FloatVector& w);
+FloatVector subtract(const FloatVector& v, const FloatVector& w);
+FloatVector scalar_multiply(float c, const FloatVector& v);
+double dot(ConstFloatSpan v, ConstFloatSpan w);
+double sum_of_squares(ConstFloatSpan v);
+double magnitude(ConstFloatSpan v);
+double squared_distance(ConstFloatSpan v, ConstFloatSpan w);
+double distance(ConstFloatSpan v, ConstFloatSpan w);
+void axpy(float a, ConstFloatSpan x, FloatSpan y);                          // y += a * x
+void scal(float a, FloatSpan x);                                            // x *= a
+void add_into(FloatSpan out, ConstFloatSpan v, ConstFloatSpan w);           // out = v + w
+void subtract_into(FloatSpan out, ConstFloatSpan v, ConstFloatSpan w);      // out = v - w
+void scale_into(FloatSpan out, float c, ConstFloatSpan v);                  // out = c * v
+void accumulate(FloatSpan acc, ConstFloatSpan v);                           // acc += v
+
 // Matrix operations
 std::pair<int, int> shape(const Matrix& A); // a std::par is like a tuple in python 
 Vector get_row(const Matrix& A, int i);
 Vector get_column(const Matrix& A, int j);
 
-Matrix make_matrix(
-    int num_rows,
-    int num_cols,
-    std::function<double(int, int)> entry_fn);
+// The generators take any callable double(int i, int j) as a template
+// parameter, so the entry function is inlined rather than called through
+// std::function. The execution::par overloads split rows across threads
+// and need an entry_fn that is safe to call concurrently.
+template<typename F>
+Matrix make_matrix(int num_rows, int num_cols, F&& entry_fn);
+template<typename F>
+Matrix make_matrix(execution::parallel_policy, int num_rows, int num_cols, F&& entry_fn);
 
 Matrix identity_matrix(int n);
+Matrix diagonal_matrix(const Vector& diagonal);
+Matrix constant_matrix(int num_rows, int num_cols, double value);
+
+// Dense (contiguous row-major) matrix operations
+std::pair<int, int> shape(const DenseMatrix& A);
+ConstVectorSpan get_row(const DenseMatrix& A, int i);      // view, no copy
+ConstStridedSpan get_column(const DenseMatrix& A, int j);  // strided view, no copy
+
+template<typename F>
+DenseMatrix make_dense_matrix(int num_rows, int num_cols, F&& entry_fn);
+template<typename F>
+DenseMatrix make_dense_matrix(execution::parallel_policy, int num_rows, int num_cols, F&& entry_fn);
+
+DenseMatrix dense_identity_matrix(int n);
+DenseMatrix dense_diagonal_matrix(ConstVectorSpan diagonal);
+DenseMatrix dense_constant_matrix(int num_rows, int num_cols, double value);
+
+// Conversions between nested and dense storage
+DenseMatrix to_dense(const Matrix& A);
+Matrix to_nested(const DenseMatrix& A);
+
+// Matrix products (cache-blocked, SIMD micro-kernels, multithreaded over
+// row blocks; thread count from ds/parallel.hpp)
+void gemm(double alpha, ConstMatrixView A, ConstMatrixView B,
+          double beta, MatrixView C);                         // C = alpha*A*B + beta*C
+DenseMatrix matrix_multiply(const DenseMatrix& A, const DenseMatrix& B);
+Matrix matrix_multiply(const Matrix& A, const Matrix& B);
+
+void gemv(double alpha, ConstMatrixView A, ConstVectorSpan x,
+          double beta, VectorSpan y);                         // y = alpha*A*x + beta*y
+Vector matvec(const DenseMatrix& A, const Vector& x);
+Vector matvec(const Matrix& A, const Vector& x);
+
+// Cache-oblivious transpose
+void transpose(ConstMatrixView A, MatrixView out);
+DenseMatrix transpose(const DenseMatrix& A);
+Matrix transpose(const Matrix& A);
+
+// ---------------- Matrix generator templates ----------------
 
- 
+namespace detail {
+// Fill one row (num_cols entries starting at out) with entry_fn(i, j)
+template<typename F>
+inline void fill_row(double* out, int i, int num_cols, F& entry_fn) {
+    for (int j = 0; j < num_cols; ++j)
+        out[j] = entry_fn(i, j);
+}
+
+// Rows per thread chunk: about 4096 entries, so tiny matrices stay serial
+inline size_t min_generator_rows(int num_cols) {
+    return std::max<size_t>(1, 4096 / std::max(1, num_cols));
+}
+} // namespace detail
+
+template<typename F>
+Matrix make_matrix(int num_rows, int num_cols, F&& entry_fn) {
+    Matrix result(num_rows, Vector(num_cols));   // every row allocated up front
+    for (int i = 0; i < num_rows; ++i)
+        detail::fill_row(result[i].data(), i, num_cols, entry_fn);
+    return result;
+}
+
+template<typename F>
+Matrix make_matrix(execution::parallel_policy, int num_rows, int num_cols, F&& entry_fn) {
+    Matrix result(num_rows, Vector(num_cols));
+    parallel_for(0, num_rows, detail::min_generator_rows(num_cols), [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i)
+            detail::fill_row(result[i].data(), static_cast<int>(i), num_cols, entry_fn);
+    });
+    return result;
+}
+
+template<typename F>
+DenseMatrix make_dense_matrix(int num_rows, int num_cols, F&& entry_fn) {
+    DenseMatrix result(num_rows, num_cols);
+    for (int i = 0; i < num_rows; ++i)
+        detail::fill_row(result.row(i).data(), i, num_cols, entry_fn);
+    return result;
+}
+
+template<typename F>
+DenseMatrix make_dense_matrix(execution::parallel_policy, int num_rows, int num_cols, F&& entry_fn) {
+    DenseMatrix result(num_rows, num_cols);
+    parallel_for(0, num_rows, detail::min_generator_rows(num_cols), [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i)
+            detail::fill_row(result.row(i).data(), static_cast<int>(i), num_cols, entry_fn);
+    });
+    return result;
+}
 
 }
 
@@ -0,0 +1,88 @@
+#if !defined(__PARALLEL__)
+#define __PARALLEL__
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+namespace ds {
+
+// ────────────────────────────────────────────────
+// Shared worker pool
+// ────────────────────────────────────────────────
+//
+// All multithreaded routines in the library run on one persistent pool.
+// Work is always split into a number of chunks that depends only on the
+// problem size and num_threads(), and partial results are combined in
+// chunk order, so results are reproducible for a fixed thread count no
+// matter which worker happens to run which chunk.
+
+/// Execution policy selecting the parallel overload of functions that also
+/// have a serial one (which is what the plain overload is); the parallel one
+/// requires callbacks to be safe to call concurrently. Modelled on the C++17
+/// std::execution::par policy.
+namespace execution {
+struct parallel_policy {};
+inline constexpr parallel_policy par{};
+} // namespace execution
+
+/// @return Number of threads parallel routines use (default: all hardware threads)
+size_t num_threads();
+
+/// Set the number of threads used by parallel routines
+/// @param n Thread count; 0 restores the hardware default
+void set_num_threads(size_t n);
+
+/// Run fn(chunk) for every chunk in [0, num_chunks) on the pool and wait.
+/// The calling thread takes part. Calls made from inside a pool task run
+/// serially on the calling thread. The first exception thrown by a task
+/// is rethrown here after all chunks finished.
+/// @param num_chunks Number of independent tasks
+/// @param fn Task body
+void parallel_for_chunks(size_t num_chunks, const std::function<void(size_t)>& fn);
+
+/// Number of chunks to split n items into: at most num_threads(), and no
+/// chunk smaller than min_chunk (but always at least one chunk).
+/// @param n Number of items
+/// @param min_chunk Smallest worthwhile chunk
+inline size_t chunk_count(size_t n, size_t min_chunk) {
+    if (min_chunk == 0) min_chunk = 1;
+    size_t by_size = (n + min_chunk - 1) / min_chunk;
+    return std::max<size_t>(1, std::min(num_threads(), by_size));
+}
+
+/// Bounds of chunk c when n items are split into num_chunks near-equal,
+/// contiguous ranges
+/// @return Half-open range [first, second)
+inline std::pair<size_t, size_t> chunk_range(size_t n, size_t num_chunks, size_t c) {
+    size_t base = n / num_chunks;
+    size_t extra = n % num_chunks;
+    size_t lo = c * base + std::min(c, extra);
+    size_t hi = lo + base + (c < extra ? 1 : 0);
+    return {lo, hi};
+}
+
+/// Run fn(lo, hi) over contiguous sub-ranges of [begin, end) in parallel
+/// @param begin First index
+/// @param end One past the last index
+/// @param min_chunk Smallest range worth handing to a thread
+/// @param fn Callable taking (size_t lo, size_t hi)
+template<typename F>
+void parallel_for(size_t begin, size_t end, size_t min_chunk, F&& fn) {
+    if (end <= begin) return;
+    const size_t n = end - begin;
+    const size_t chunks = chunk_count(n, min_chunk);
+    if (chunks == 1) {
+        fn(begin, end);
+        return;
+    }
+    parallel_for_chunks(chunks, [&](size_t c) {
+        auto [lo, hi] = chunk_range(n, chunks, c);
+        fn(begin + lo, begin + hi);
+    });
+}
+
+} // namespace ds
+
+#endif // __PARALLEL__
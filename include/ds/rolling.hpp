@@ -0,0 +1,154 @@
+#if !defined(__ROLLING__)
+#define __ROLLING__
+
+#include <cstddef>
+#include <deque>
+#include <set>
+#include "ds/linear_algebra.hpp"
+
+namespace ds {
+
+// ────────────────────────────────────────────────
+// Rolling-window statistics
+// ────────────────────────────────────────────────
+//
+// Statistics over the most recent part of a stream, updated as values
+// arrive and expire instead of recomputed per window:
+//
+//   * RollingStats / RollingCovariance: O(1) per value. Welford's update
+//     adds a value and its exact inverse removes one; the window is
+//     re-summed from scratch once per window length of removals, so
+//     rounding drift cannot build up (amortized O(1)), and whenever a NaN
+//     or infinity leaves it, since those cannot be subtracted back out.
+//   * RollingQuantile: O(log w) per value. The window is split into two
+//     ordered multisets, the values below the requested rank and the rest,
+//     so the quantile is the smallest element of the upper set.
+//
+// A window holds either the last n values or the values whose timestamp
+// lies within a duration of the newest one.
+
+/// Which values a rolling statistic covers
+struct Window {
+    /// The last n values (push without timestamps)
+    static Window last(size_t n);
+
+    /// Values with timestamp t > newest - duration (push with
+    /// non-decreasing timestamps)
+    static Window within(double duration);
+
+    size_t count = 0;       // > 0 for count windows
+    double duration = 0.0;  // > 0 for time windows
+};
+
+/// Count, mean and variance over a rolling window
+class RollingStats {
+public:
+    explicit RollingStats(Window window);
+
+    void push(double x);              // count windows
+    void push(double t, double x);    // time windows
+
+    size_t count() const noexcept { return values_.size(); }
+    double mean() const noexcept { return mean_; }
+
+    /// @return Sample variance of the window; needs count >= 2
+    double variance() const;
+    double standard_deviation() const;
+
+private:
+    struct Entry { double t, x; };
+
+    void insert(double t, double x);
+    void evict(double newest);
+    void recompute();
+
+    Window window_;
+    std::deque<Entry> values_;
+    double mean_ = 0.0;
+    double m2_ = 0.0;
+    size_t pushed_ = 0;     // timestamps of count windows
+    size_t removed_ = 0;    // removals since the last exact re-sum
+};
+
+/// Means, variances, covariance and correlation over a rolling window of
+/// (x, y) pairs
+class RollingCovariance {
+public:
+    explicit RollingCovariance(Window window);
+
+    void push(double x, double y);              // count windows
+    void push(double t, double x, double y);    // time windows
+
+    size_t count() const noexcept { return values_.size(); }
+    double mean_x() const noexcept { return mean_x_; }
+    double mean_y() const noexcept { return mean_y_; }
+
+    /// Sample statistics of the window; need count >= 2
+    double variance_x() const;
+    double variance_y() const;
+    double covariance() const;
+
+    /// @return Pearson correlation, or 0 if either variable is constant
+    double correlation() const;
+
+private:
+    struct Entry { double t, x, y; };
+
+    void insert(double t, double x, double y);
+    void evict(double newest);
+    void recompute();
+
+    Window window_;
+    std::deque<Entry> values_;
+    double mean_x_ = 0.0, mean_y_ = 0.0;
+    double m2_x_ = 0.0, m2_y_ = 0.0, c_xy_ = 0.0;
+    size_t pushed_ = 0;
+    size_t removed_ = 0;
+};
+
+/// One quantile (e.g. the median) over a rolling window
+class RollingQuantile {
+public:
+    /// @param p Fraction in [0, 1]; same rank convention as quantile()
+    RollingQuantile(Window window, double p = 0.5);
+
+    void push(double x);              // count windows
+    void push(double t, double x);    // time windows
+
+    size_t count() const noexcept { return values_.size(); }
+
+    /// @return The p-quantile of the window, or NaN while the window holds
+    ///         a NaN (like RollingStats); needs count >= 1
+    double quantile() const;
+
+    /// @return The median of the window (averaging the two middle values
+    ///         like median()); needs p == 0.5
+    double median() const;
+
+private:
+    struct Entry { double t, x; };
+
+    void insert(double x);
+    void erase(double x);
+    void rebalance();
+    void evict(double newest);
+
+    Window window_;
+    double p_;
+    std::deque<Entry> values_;
+    std::multiset<double> lower_;   // the values of rank < floor(p * n)
+    std::multiset<double> upper_;   // the rest
+    size_t nans_ = 0;               // NaNs in the window, kept out of both sets
+    size_t pushed_ = 0;
+};
+
+// Whole-series helpers: one result per full window of `window` values
+// (xs.size() - window + 1 results), each in O(1) / O(log window)
+Vector rolling_mean(ConstVectorSpan xs, size_t window);
+Vector rolling_variance(ConstVectorSpan xs, size_t window);
+Vector rolling_median(ConstVectorSpan xs, size_t window);
+Vector rolling_quantile(ConstVectorSpan xs, size_t window, double p);
+
+} // namespace ds
+
+#endif // __ROLLING__
@@ -0,0 +1,60 @@
+#if !defined(__SIMD__)
+#define __SIMD__
+
+namespace ds {
+
+// ────────────────────────────────────────────────
+// Runtime SIMD dispatch
+// ────────────────────────────────────────────────
+//
+// dot, sum_of_squares, squared_distance, distance, add, subtract,
+// scalar_multiply and the in-place axpy / scal / *_into / accumulate
+// family run on kernels selected once at startup from the best instruction
+// set the CPU (and OS) supports. The choice can be overridden with the
+// DS_SIMD environment variable (scalar | sse2 | avx2 | avx512) or with
+// set_simd_level().
+//
+// Accuracy contract
+//   * add, subtract and scalar_multiply perform exactly one IEEE operation
+//     per element, and axpy a separate multiply and add (never FMA), so
+//     their results are bitwise identical at every level.
+//   * Reductions (dot, sum_of_squares, squared_distance) keep K independent
+//     partial sums (K = 4 scalar, 8 SSE2, 16 AVX2, 32 AVX-512) that are
+//     combined in a fixed pairwise order; AVX2 and AVX-512 use fused
+//     multiply-add. With u = 2^-53 the error satisfies
+//         |computed - exact| <= (n / K + log2(K) + 2) * u * sum_i |a_i * b_i|
+//     which is never worse than the naive single-accumulator loop
+//     (n * u * sum_i |a_i * b_i|).
+//   * The float (FloatVector) kernels follow the same rules: elementwise ops
+//     are one float operation per element, and reductions convert every
+//     element to double first (float products are exact in double) and
+//     use the same accumulators, so the bound above holds with u = 2^-53.
+//   * For a fixed level and input the result is deterministic; different
+//     levels may differ in the last few bits.
+
+/// Instruction-set levels, ordered from least to most capable
+enum class SimdLevel {
+    Scalar = 0,
+    SSE2   = 1,
+    AVX2   = 2,   // AVX2 + FMA
+    AVX512 = 3    // AVX-512F
+};
+
+/// @return The best level supported by this CPU and build
+SimdLevel detected_simd_level();
+
+/// @return The level currently used by the dispatched kernels
+SimdLevel simd_level();
+
+/// Force a dispatch level (e.g. for benchmarking or reproducibility).
+/// Requests above detected_simd_level() are clamped to it.
+/// @param level The requested level
+/// @return The level actually selected
+SimdLevel set_simd_level(SimdLevel level);
+
+/// @return "scalar", "sse2", "avx2" or "avx512"
+const char* simd_level_name(SimdLevel level);
+
+} // namespace ds
+
+#endif // __SIMD__
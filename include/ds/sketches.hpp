@@ -0,0 +1,196 @@
+#if !defined(__SKETCHES__)
+#define __SKETCHES__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include "ds/linear_algebra.hpp"
+
+namespace ds {
+
+// ────────────────────────────────────────────────
+// Mergeable sketches
+// ────────────────────────────────────────────────
+//
+// Approximate summaries of unbounded streams with bounded memory. Like the
+// accumulators, each can be fed a value or a chunk at a time, and sketches
+// of disjoint parts of the data (threads, shards, files) merge into the
+// sketch of the whole.
+
+namespace detail {
+
+/// Bit pattern used to identify a value in the hashed summaries; 0.0 and
+/// -0.0 are the same value (as with ==), and NaNs with equal bits count
+/// as equal
+inline uint64_t value_key(double x) noexcept {
+    if (x == 0.0) return 0;
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof bits);
+    return bits;
+}
+
+/// Well-mixed 64-bit hash of a value key (splitmix64 finalizer)
+inline uint64_t hash_key(uint64_t key, uint64_t seed = 0) noexcept {
+    uint64_t z = key + seed * 0x9e3779b97f4a7c15ull + 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+} // namespace detail
+
+/// KLL quantile sketch (Karnin, Lang & Liberty, 2016)
+///
+/// Values are kept in a stack of compactors: level h holds items that each
+/// stand for 2^h inputs. When a level is full it is sorted and every other
+/// item (random odd/even offset) is promoted, halving its size while
+/// keeping ranks unbiased. Capacities shrink by 2/3 per level below the
+/// top, so about 3k values are retained regardless of the stream length.
+///
+/// Rank error: a returned quantile's true rank is within about 1.65% of n
+/// of the requested one for k = 200 (99% confidence), and the error scales
+/// as 1/k. The same bound holds after any sequence of merges. min() and
+/// max() are exact, so quantile(0) and quantile(1) are too.
+class QuantileSketch {
+public:
+    /// @param k Accuracy parameter (>= 8); memory is about 3k doubles
+    explicit QuantileSketch(size_t k = 200);
+
+    /// Add one value
+    void push(double x);
+
+    /// Add a chunk of values
+    void push(ConstVectorSpan xs);
+
+    /// Fold in the sketch of another (disjoint) part of the data; both
+    /// sketches should use the same k
+    void merge(const QuantileSketch& other);
+
+    size_t count() const noexcept { return count_; }
+    double min() const noexcept { return min_; }
+    double max() const noexcept { return max_; }
+
+    /// @return Number of values currently stored
+    size_t retained() const noexcept { return retained_; }
+
+    /// @param p Fraction in [0, 1]
+    /// @return Approximate p-quantile, same rank convention as quantile()
+    ///         (the value of rank floor(p * n)); needs count >= 1
+    double quantile(double p) const;
+
+    /// Several quantiles from one sorted view of the sketch
+    /// @return Results in the order of ps
+    Vector quantiles(const Vector& ps) const;
+
+    double median() const;
+    double interquartile_range() const;
+
+    /// @return Approximate fraction of the values that are <= x
+    double rank(double x) const;
+
+private:
+    size_t capacity(size_t level) const;
+    void update_capacity();
+    void compress();
+
+    size_t k_;
+    size_t count_ = 0;
+    size_t retained_ = 0;
+    size_t capacity_ = 0;          // sum of the level capacities
+    double min_ = std::numeric_limits<double>::infinity();
+    double max_ = -std::numeric_limits<double>::infinity();
+    std::vector<Vector> levels_;   // levels_[h]: items of weight 2^h
+    uint64_t rng_ = 0x9e3779b97f4a7c15ull;   // xorshift state for the offsets
+};
+
+/// Space-Saving heavy hitters (Metwally, Agrawal & El Abbadi, 2005)
+///
+/// Tracks at most `capacity` values with a counter each. A new value takes
+/// over the counter of the least frequent tracked one and inherits its
+/// count as error, so every count overestimates the true frequency by at
+/// most its error, and the error is at most n / capacity. Every value
+/// that occurs more than n / capacity times is guaranteed to be tracked.
+/// Merging adds the counts of both summaries (a value missing from a full
+/// summary is charged that summary's minimum), which keeps both bounds.
+class HeavyHitters {
+public:
+    struct Item {
+        double value;
+        uint64_t count;   // estimate, >= true frequency
+        uint64_t error;   // count - error <= true frequency
+    };
+
+    /// @param capacity Number of counters (>= 1)
+    explicit HeavyHitters(size_t capacity = 64);
+
+    /// Add one value
+    void push(double x);
+
+    /// Add a chunk of values
+    void push(ConstVectorSpan xs);
+
+    /// Fold in the summary of another (disjoint) part of the data
+    void merge(const HeavyHitters& other);
+
+    uint64_t count() const noexcept { return count_; }
+
+    /// @return Up to k tracked values, most frequent first
+    std::vector<Item> top(size_t k) const;
+
+    /// @return The values with the highest estimated count, ascending;
+    ///         exact when the true mode occurs more than n / capacity
+    ///         times more often than the runner-up
+    Vector mode() const;
+
+private:
+    size_t find_slot(uint64_t key) const;   // slot holding key, or an empty one
+    void erase_slot(size_t slot);
+    void swap_items(size_t a, size_t b);
+    void sift_down(size_t i);
+    void rebuild_slots();
+
+    size_t capacity_;
+    uint64_t count_ = 0;
+    std::vector<Item> heap_;        // min-heap on count
+    std::vector<uint32_t> slots_;   // open addressing: heap index + 1, 0 = empty
+};
+
+/// Count-Min sketch (Cormode & Muthukrishnan, 2005)
+///
+/// A depth x width table of counters; a value increments one counter per
+/// row and its frequency estimate is the smallest of them. Estimates never
+/// undercount, and overcount by at most e * n / width with probability
+/// 1 - e^-depth. Unlike HeavyHitters it answers for any value, not just
+/// the frequent ones. Sketches with the same shape merge by adding tables.
+class CountMinSketch {
+public:
+    /// @param width Counters per row (error ~ e * n / width)
+    /// @param depth Rows (failure probability e^-depth)
+    explicit CountMinSketch(size_t width = 2048, size_t depth = 4);
+
+    /// Add `times` occurrences of x
+    void push(double x, uint64_t times = 1);
+
+    /// Add a chunk of values
+    void push(ConstVectorSpan xs);
+
+    /// Fold in a sketch of another part of the data (same width and depth)
+    void merge(const CountMinSketch& other);
+
+    uint64_t count() const noexcept { return count_; }
+
+    /// @return Estimated number of occurrences of x (never too small)
+    uint64_t estimate(double x) const;
+
+private:
+    size_t width_;
+    size_t depth_;
+    uint64_t count_ = 0;
+    std::vector<uint64_t> table_;   // depth_ rows of width_ counters
+};
+
+} // namespace ds
+
+#endif // __SKETCHES__
@@ -0,0 +1,110 @@
+#if !defined(__SPAN__)
+#define __SPAN__
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace ds {
+
+// ────────────────────────────────────────────────
+// Non-owning views over caller-owned memory
+// ────────────────────────────────────────────────
+
+/// A contiguous, non-owning view of `size()` elements (a minimal C++17
+/// stand-in for std::span). Converts implicitly from std::vector so any
+/// function taking a Span also accepts a Vector without copying.
+/// @tparam T Element type; use `const double` for read-only views
+template<typename T>
+class Span {
+public:
+    using element_type = T;
+    using value_type   = std::remove_cv_t<T>;
+    using iterator     = T*;
+
+    constexpr Span() noexcept = default;
+    constexpr Span(T* data, size_t size) noexcept : data_(data), size_(size) {}
+
+    template<typename U, typename Alloc,
+             typename = std::enable_if_t<std::is_convertible<U (*)[], T (*)[]>::value>>
+    Span(std::vector<U, Alloc>& v) noexcept : data_(v.data()), size_(v.size()) {}
+
+    template<typename U, typename Alloc,
+             typename = std::enable_if_t<std::is_const<T>::value &&
+                                         std::is_same<std::remove_cv_t<T>, U>::value>>
+    Span(const std::vector<U, Alloc>& v) noexcept : data_(v.data()), size_(v.size()) {}
+
+    /// Allow Span<double> -> Span<const double>
+    template<typename U,
+             typename = std::enable_if_t<!std::is_same<U, T>::value &&
+                                         std::is_convertible<U (*)[], T (*)[]>::value>>
+    constexpr Span(const Span<U>& other) noexcept : data_(other.data()), size_(other.size()) {}
+
+    constexpr T* data() const noexcept { return data_; }
+    constexpr size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    constexpr T* begin() const noexcept { return data_; }
+    constexpr T* end() const noexcept { return data_ + size_; }
+
+    T& operator[](size_t i) const {
+        assert(i < size_);
+        return data_[i];
+    }
+
+    /// @return The view of elements [offset, offset + count)
+    Span subspan(size_t offset, size_t count) const {
+        assert(offset + count <= size_);
+        return Span(data_ + offset, count);
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/// A non-owning view of `size()` elements spaced `stride()` apart, e.g. a
+/// column of a row-major matrix.
+template<typename T>
+class StridedSpan {
+public:
+    using element_type = T;
+    using value_type   = std::remove_cv_t<T>;
+
+    constexpr StridedSpan() noexcept = default;
+    constexpr StridedSpan(T* data, size_t size, size_t stride) noexcept
+        : data_(data), size_(size), stride_(stride) {}
+
+    template<typename U,
+             typename = std::enable_if_t<!std::is_same<U, T>::value &&
+                                         std::is_convertible<U (*)[], T (*)[]>::value>>
+    constexpr StridedSpan(const StridedSpan<U>& other) noexcept
+        : data_(other.data()), size_(other.size()), stride_(other.stride()) {}
+
+    constexpr T* data() const noexcept { return data_; }
+    constexpr size_t size() const noexcept { return size_; }
+    constexpr size_t stride() const noexcept { return stride_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    T& operator[](size_t i) const {
+        assert(i < size_);
+        return data_[i * stride_];
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+    size_t stride_ = 1;
+};
+
+using VectorSpan        = Span<double>;
+using ConstVectorSpan   = Span<const double>;
+using StridedVectorSpan = StridedSpan<double>;
+using ConstStridedSpan  = StridedSpan<const double>;
+using FloatSpan         = Span<float>;
+using ConstFloatSpan    = Span<const float>;
+
+} // namespace ds
+
+#endif // __SPAN__
@@ -0,0 +1,212 @@
+#if !defined(__SPARSE__)
+#define __SPARSE__
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+#include "ds/linear_algebra.hpp"
+
+namespace ds {
+
+// ────────────────────────────────────────────────
+// Sparse vectors
+// ────────────────────────────────────────────────
+//
+// One-hot and bag-of-words features are almost entirely zeros. A sparse
+// vector stores only its non-zero entries as (index, value) pairs sorted by
+// index, so every operation below costs O(nnz) instead of O(dim), and
+// sparse-sparse operations are a single merge of the two index lists.
+
+/// Read-only view of a sparse vector: a SparseVector, a CSR row or a CSC
+/// column. Indices are strictly increasing and smaller than dim.
+struct SparseView {
+    size_t dim = 0;
+    Span<const size_t> indices;
+    ConstVectorSpan values;
+
+    size_t nnz() const noexcept { return indices.size(); }
+};
+
+/// A vector of dimension dim() holding only its non-zero entries
+class SparseVector {
+public:
+    SparseVector() = default;
+
+    /// @param dim Dimension of the (all-zero) vector
+    explicit SparseVector(size_t dim) : dim_(dim) {}
+
+    /// Build from unordered entries; duplicate indices are summed
+    /// @param dim Dimension of the vector
+    /// @param indices Positions of the entries (each < dim)
+    /// @param values Values of the entries
+    SparseVector(size_t dim, std::vector<size_t> indices, Vector values);
+
+    size_t dim() const noexcept { return dim_; }
+    size_t nnz() const noexcept { return indices_.size(); }
+
+    const std::vector<size_t>& indices() const noexcept { return indices_; }
+    const Vector& values() const noexcept { return values_; }
+    Vector& values() noexcept { return values_; }
+
+    /// Append an entry; its index must be larger than every stored index
+    void push_back(size_t index, double value) {
+        assert(index < dim_ && (indices_.empty() || index > indices_.back()));
+        indices_.push_back(index);
+        values_.push_back(value);
+    }
+
+    void reserve(size_t nnz) {
+        indices_.reserve(nnz);
+        values_.reserve(nnz);
+    }
+
+    SparseView view() const noexcept { return {dim_, indices_, values_}; }
+    operator SparseView() const noexcept { return view(); }
+
+private:
+    size_t dim_ = 0;
+    std::vector<size_t> indices_;
+    Vector values_;
+};
+
+/// @param v Dense vector
+/// @return Its non-zero entries as a SparseVector
+SparseVector to_sparse(ConstVectorSpan v);
+
+/// @return The dense form of x
+Vector to_dense(SparseView x);
+
+// Sparse-dense and sparse-sparse dot products
+double dot(SparseView x, ConstVectorSpan y);
+double dot(ConstVectorSpan x, SparseView y);
+double dot(SparseView x, SparseView y);
+
+double sum_of_squares(SparseView x);
+double magnitude(SparseView x);
+
+// Squared distances; a sparse-dense distance costs O(dim) because every
+// entry of the dense side counts
+double squared_distance(SparseView x, SparseView y);
+double squared_distance(SparseView x, ConstVectorSpan y);
+double squared_distance(ConstVectorSpan x, SparseView y);
+
+// Sparse results of sparse-sparse arithmetic
+SparseVector add(SparseView x, SparseView y);
+SparseVector subtract(SparseView x, SparseView y);
+SparseVector scalar_multiply(double c, SparseView x);
+
+/// y += a * x, touching only the non-zeros of x
+void axpy(double a, SparseView x, VectorSpan y);
+
+/// y += a * x for a sparse y; y's pattern becomes the union of both
+void axpy(double a, SparseView x, SparseVector& y);
+
+// ────────────────────────────────────────────────
+// Compressed sparse matrices
+// ────────────────────────────────────────────────
+
+/// One entry of a matrix given as (row, column, value)
+struct Triplet {
+    size_t row;
+    size_t col;
+    double value;
+};
+
+/// Compressed sparse row matrix: the entries of row i are
+/// col_idx()/values()[row_ptr()[i], row_ptr()[i + 1]), sorted by column.
+/// Rows are cheap SparseViews and A x is a parallel sweep over rows.
+class CsrMatrix {
+public:
+    CsrMatrix() : row_ptr_(1, 0) {}
+
+    /// Take ownership of already-compressed arrays
+    CsrMatrix(size_t rows, size_t cols, std::vector<size_t> row_ptr,
+              std::vector<size_t> col_idx, Vector values);
+
+    size_t rows() const noexcept { return rows_; }
+    size_t cols() const noexcept { return cols_; }
+    size_t nnz() const noexcept { return values_.size(); }
+
+    const std::vector<size_t>& row_ptr() const noexcept { return row_ptr_; }
+    const std::vector<size_t>& col_idx() const noexcept { return col_idx_; }
+    const Vector& values() const noexcept { return values_; }
+
+    SparseView row(size_t i) const {
+        assert(i < rows_);
+        const size_t lo = row_ptr_[i], n = row_ptr_[i + 1] - lo;
+        return {cols_, {col_idx_.data() + lo, n}, {values_.data() + lo, n}};
+    }
+
+private:
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    std::vector<size_t> row_ptr_;
+    std::vector<size_t> col_idx_;
+    Vector values_;
+};
+
+/// Compressed sparse column matrix: the column-major twin of CsrMatrix.
+/// Columns are cheap SparseViews, which suits per-feature statistics.
+class CscMatrix {
+public:
+    CscMatrix() : col_ptr_(1, 0) {}
+
+    /// Take ownership of already-compressed arrays
+    CscMatrix(size_t rows, size_t cols, std::vector<size_t> col_ptr,
+              std::vector<size_t> row_idx, Vector values);
+
+    size_t rows() const noexcept { return rows_; }
+    size_t cols() const noexcept { return cols_; }
+    size_t nnz() const noexcept { return values_.size(); }
+
+    const std::vector<size_t>& col_ptr() const noexcept { return col_ptr_; }
+    const std::vector<size_t>& row_idx() const noexcept { return row_idx_; }
+    const Vector& values() const noexcept { return values_; }
+
+    SparseView column(size_t j) const {
+        assert(j < cols_);
+        const size_t lo = col_ptr_[j], n = col_ptr_[j + 1] - lo;
+        return {rows_, {row_idx_.data() + lo, n}, {values_.data() + lo, n}};
+    }
+
+private:
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    std::vector<size_t> col_ptr_;
+    std::vector<size_t> row_idx_;
+    Vector values_;
+};
+
+/// Build a CSR matrix from entries in any order; duplicates are summed
+/// @param rows Number of rows
+/// @param cols Number of columns
+/// @param entries Non-zero entries
+CsrMatrix make_csr(size_t rows, size_t cols, const std::vector<Triplet>& entries);
+
+/// Stack sparse row vectors (e.g. one encoded document per row)
+/// @param rows Rows of the matrix, all of the same dimension
+CsrMatrix make_csr(const std::vector<SparseVector>& rows);
+
+CsrMatrix to_csr(ConstMatrixView A);
+CsrMatrix to_csr(const CscMatrix& A);
+CscMatrix to_csc(const CsrMatrix& A);
+DenseMatrix to_dense(const CsrMatrix& A);
+DenseMatrix to_dense(const CscMatrix& A);
+
+/// Sparse matrix-vector product y = alpha * A * x + beta * y
+/// (beta == 0 overwrites y without reading it)
+void gemv(double alpha, const CsrMatrix& A, ConstVectorSpan x,
+          double beta, VectorSpan y);
+void gemv(double alpha, const CscMatrix& A, ConstVectorSpan x,
+          double beta, VectorSpan y);
+
+/// @return A * x
+Vector matvec(const CsrMatrix& A, const Vector& x);
+Vector matvec(const CscMatrix& A, const Vector& x);
+
+/// @return A^T * x (a scatter over the rows of A; no transpose is formed)
+Vector matvec_transpose(const CsrMatrix& A, const Vector& x);
+
+} // namespace ds
+
+#endif // __SPARSE__
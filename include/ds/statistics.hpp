@@ -2,11 +2,19 @@
 #define __STATISTICS__
 #include <vector>
 #include "ds/linear_algebra.hpp"
+#include "ds/accumulators.hpp"
+#include "ds/sparse.hpp"
 namespace ds {
     // a function called mean  
     double mean(const Vector& ); 
     double median(const Vector& ); 
     double quantile(const Vector& ,double );
+    // several quantiles for the price of about one selection; results are
+    // in the order of ps
+    Vector quantiles(const Vector&, const Vector& ps);
+    // fast path for data already in ascending order (no copy, O(1) each)
+    double quantile_sorted(const Vector&, double);
+    Vector quantiles_sorted(const Vector&, const Vector& ps);
     Vector mode(const Vector& );
     double data_range(const Vector& );
     Vector de_mean(const Vector&); 
@@ -15,6 +23,52 @@ namespace ds {
     double interquartile_range(const Vector&);
     double covariance(const Vector&, const Vector&);
     double correlation(const Vector&,const Vector&);
+
+    // multithreaded versions (execution::par; thread count from
+    // set_num_threads()): contiguous chunks are summarized on the pool and
+    // combined in order with the stable pairwise merges of accumulators.hpp,
+    // so a fixed thread count gives reproducible results
+    double mean(execution::parallel_policy, const Vector&);
+    double variance(execution::parallel_policy, const Vector&);
+    double standard_deviation(execution::parallel_policy, const Vector&);
+    double data_range(execution::parallel_policy, const Vector&);
+    Vector de_mean(execution::parallel_policy, const Vector&);
+    double covariance(execution::parallel_policy, const Vector&, const Vector&);
+    double correlation(execution::parallel_policy, const Vector&, const Vector&);
+
+    // all pairs at once: X holds n observations (rows) of k variables
+    // (columns); the result is k x k. Each column is centered once and the
+    // pairs come from one blocked, multithreaded symmetric product.
+    DenseMatrix covariance_matrix(ConstMatrixView X);
+    DenseMatrix correlation_matrix(ConstMatrixView X);   // 0 for constant columns
+
+    // views of caller-owned (e.g. memory-mapped) data, no copy
+    double mean(ConstVectorSpan);
+    double median(ConstVectorSpan);
+    double quantile(ConstVectorSpan, double);
+    Vector quantiles(ConstVectorSpan, const Vector& ps);
+    double data_range(ConstVectorSpan);
+    double variance(ConstVectorSpan);
+    double standard_deviation(ConstVectorSpan);
+    double interquartile_range(ConstVectorSpan);
+    double covariance(ConstVectorSpan, ConstVectorSpan);
+    double correlation(ConstVectorSpan, ConstVectorSpan);
+
+    // float data: read as float, accumulated in double (mixed precision),
+    // so a pass moves half the bytes of the Vector versions
+    double mean(ConstFloatSpan);
+    double variance(ConstFloatSpan);
+    double standard_deviation(ConstFloatSpan);
+    double covariance(ConstFloatSpan, ConstFloatSpan);
+    double correlation(ConstFloatSpan, ConstFloatSpan);
+
+    // sparse data (e.g. a column of a CscMatrix): entries that are not
+    // stored count as zeros, and the cost is O(nnz), not O(dim)
+    double mean(SparseView);
+    double variance(SparseView);
+    double standard_deviation(SparseView);
+    double covariance(SparseView, SparseView);
+    double correlation(SparseView, SparseView);
 }
 
 #endif // __STATISTICS__
@@ -0,0 +1,230 @@
+#if !defined(__VECTOR_EXPR__)
+#define __VECTOR_EXPR__
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include "ds/span.hpp"
+
+namespace ds {
+
+// ────────────────────────────────────────────────
+// Lazy vector expressions
+// ────────────────────────────────────────────────
+//
+// `v + step * g` or `v - w` build a small expression object instead of a
+// new Vector. Nothing is computed until the expression is assigned to a
+// Vector (one allocation, one loop) or reduced by dot / sum_of_squares /
+// magnitude (no allocation at all). Expressions hold pointers to their
+// operands, so they must not outlive the vectors they were built from.
+
+/// CRTP base of every vector expression
+template<typename E>
+struct VectorExpr {
+    const E& self() const { return static_cast<const E&>(*this); }
+
+    size_t size() const { return self().size(); }
+    double operator[](size_t i) const { return self()[i]; }
+
+    /// Materialize the expression: `Vector r = v + w;`
+    operator std::vector<double>() const {
+        std::vector<double> result(size());
+        for (size_t i = 0; i < result.size(); ++i)
+            result[i] = self()[i];
+        return result;
+    }
+};
+
+namespace expr {
+
+/// Leaf: a read-only reference to contiguous storage
+struct Ref : VectorExpr<Ref> {
+    const double* data;
+    size_t n;
+
+    Ref(const double* data, size_t n) : data(data), n(n) {}
+
+    size_t size() const { return n; }
+    double operator[](size_t i) const { return data[i]; }
+};
+
+struct Plus  { static double apply(double a, double b) { return a + b; } };
+struct Minus { static double apply(double a, double b) { return a - b; } };
+struct Times { static double apply(double a, double b) { return a * b; } };
+
+/// Elementwise binary node
+template<typename Op, typename L, typename R>
+struct Binary : VectorExpr<Binary<Op, L, R>> {
+    L l;
+    R r;
+
+    Binary(const L& l, const R& r) : l(l), r(r) {
+        assert(l.size() == r.size());
+    }
+
+    size_t size() const { return l.size(); }
+    double operator[](size_t i) const { return Op::apply(l[i], r[i]); }
+};
+
+/// Scalar multiple of an expression
+template<typename E>
+struct Scaled : VectorExpr<Scaled<E>> {
+    double c;
+    E e;
+
+    Scaled(double c, const E& e) : c(c), e(e) {}
+
+    size_t size() const { return e.size(); }
+    double operator[](size_t i) const { return c * e[i]; }
+};
+
+// Operand adaptation: Vectors and spans become Ref leaves, expressions are
+// stored by value (they are a few pointers wide).
+
+inline Ref leaf(const std::vector<double>& v) { return Ref(v.data(), v.size()); }
+inline Ref leaf(Span<const double> v) { return Ref(v.data(), v.size()); }
+inline Ref leaf(Span<double> v) { return Ref(v.data(), v.size()); }
+
+template<typename E>
+const E& leaf(const VectorExpr<E>& e) { return e.self(); }
+
+template<typename T>
+using leaf_t = std::decay_t<decltype(leaf(std::declval<const T&>()))>;
+
+template<typename T>
+struct is_expr : std::is_base_of<VectorExpr<std::decay_t<T>>, std::decay_t<T>> {};
+
+template<typename T>
+struct is_plain : std::integral_constant<bool,
+    std::is_same<std::decay_t<T>, std::vector<double>>::value ||
+    std::is_same<std::decay_t<T>, Span<const double>>::value ||
+    std::is_same<std::decay_t<T>, Span<double>>::value> {};
+
+template<typename T>
+struct is_operand : std::integral_constant<bool, is_expr<T>::value || is_plain<T>::value> {};
+
+/// Operators only participate when both operands are Vectors, spans or
+/// expressions, so they never hijack unrelated types.
+template<typename L, typename R>
+using enable_binary_t = std::enable_if_t<is_operand<L>::value && is_operand<R>::value>;
+
+/// Reductions over plain Vectors are handled by the non-template overloads
+/// in linear_algebra.hpp; the templates only take over when an expression
+/// is involved.
+template<typename L, typename R>
+using enable_reduction_t = std::enable_if_t<is_operand<L>::value && is_operand<R>::value &&
+                                            (is_expr<L>::value || is_expr<R>::value)>;
+
+/// Fused sum of f(i) for i in [0, n) with four independent accumulators,
+/// so the additions do not form one serial dependency chain.
+template<typename F>
+double sum_indexed(size_t n, F f) {
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += f(i);
+        s1 += f(i + 1);
+        s2 += f(i + 2);
+        s3 += f(i + 3);
+    }
+    for (; i < n; ++i)
+        s0 += f(i);
+    return (s0 + s1) + (s2 + s3);
+}
+
+} // namespace expr
+
+// ────────────────────────────────────────────────
+// Expression-building operators
+// ────────────────────────────────────────────────
+
+template<typename L, typename R, typename = expr::enable_binary_t<L, R>>
+expr::Binary<expr::Plus, expr::leaf_t<L>, expr::leaf_t<R>>
+operator+(const L& l, const R& r) {
+    return {expr::leaf(l), expr::leaf(r)};
+}
+
+template<typename L, typename R, typename = expr::enable_binary_t<L, R>>
+expr::Binary<expr::Minus, expr::leaf_t<L>, expr::leaf_t<R>>
+operator-(const L& l, const R& r) {
+    return {expr::leaf(l), expr::leaf(r)};
+}
+
+/// Elementwise (Hadamard) product
+template<typename L, typename R, typename = expr::enable_binary_t<L, R>>
+expr::Binary<expr::Times, expr::leaf_t<L>, expr::leaf_t<R>>
+hadamard(const L& l, const R& r) {
+    return {expr::leaf(l), expr::leaf(r)};
+}
+
+template<typename T, typename = std::enable_if_t<expr::is_operand<T>::value>>
+expr::Scaled<expr::leaf_t<T>> operator*(double c, const T& v) {
+    return {c, expr::leaf(v)};
+}
+
+template<typename T, typename = std::enable_if_t<expr::is_operand<T>::value>>
+expr::Scaled<expr::leaf_t<T>> operator*(const T& v, double c) {
+    return {c, expr::leaf(v)};
+}
+
+template<typename T, typename = std::enable_if_t<expr::is_operand<T>::value>>
+expr::Scaled<expr::leaf_t<T>> operator/(const T& v, double c) {
+    return {1.0 / c, expr::leaf(v)};
+}
+
+template<typename T, typename = std::enable_if_t<expr::is_operand<T>::value>>
+expr::Scaled<expr::leaf_t<T>> operator-(const T& v) {
+    return {-1.0, expr::leaf(v)};
+}
+
+// ────────────────────────────────────────────────
+// Evaluation and fused reductions
+// ────────────────────────────────────────────────
+
+/// Materialize an expression into a new Vector
+template<typename E>
+std::vector<double> eval(const VectorExpr<E>& e) {
+    return e;
+}
+
+/// Evaluate `e` into `out`, resizing it if needed. `out` may appear in the
+/// expression itself (`assign(v, v + step * g)`): every element is read
+/// before it is written.
+template<typename E>
+void assign(std::vector<double>& out, const VectorExpr<E>& e) {
+    const E& x = e.self();
+    out.resize(x.size());
+    double* o = out.data();
+    for (size_t i = 0; i < out.size(); ++i)
+        o[i] = x[i];
+}
+
+/// Fused dot product; at least one argument is an expression
+template<typename L, typename R, typename = expr::enable_reduction_t<L, R>>
+double dot(const L& l, const R& r) {
+    const auto a = expr::leaf(l);
+    const auto b = expr::leaf(r);
+    assert(a.size() == b.size());
+    return expr::sum_indexed(a.size(), [&](size_t i) { return a[i] * b[i]; });
+}
+
+/// Fused sum of squares, e.g. `sum_of_squares(v - w)` without a temporary
+template<typename E>
+double sum_of_squares(const VectorExpr<E>& e) {
+    const E& x = e.self();
+    return expr::sum_indexed(x.size(), [&](size_t i) {
+        const double xi = x[i];
+        return xi * xi;
+    });
+}
+
+template<typename E>
+double magnitude(const VectorExpr<E>& e) {
+    return std::sqrt(sum_of_squares(e));
+}
+
+} // namespace ds
+
+#endif // __VECTOR_EXPR__
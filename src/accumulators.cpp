@@ -0,0 +1,155 @@
+#include "ds/accumulators.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace ds {
+namespace {
+
+// Chunks are summarized in blocks this long: two passes over a block stay
+// in L1, so the stream itself is read once
+constexpr size_t kBlock = 2048;
+
+} // namespace
+
+// ---------------- RunningStats ----------------
+
+void RunningStats::push(double x) {
+    ++count_;
+    const double delta = x - mean_;
+    mean_ += delta / count_;
+    m2_ += delta * (x - mean_);
+    min_ = std::min(min_, x);
+    max_ = std::max(max_, x);
+}
+
+void RunningStats::push(ConstVectorSpan xs) {
+    for (size_t lo = 0; lo < xs.size(); lo += kBlock) {
+        const size_t n = std::min(kBlock, xs.size() - lo);
+        const double* x = xs.data() + lo;
+
+        RunningStats block;
+        double sum = 0.0, lo_val = x[0], hi_val = x[0];
+        for (size_t i = 0; i < n; ++i) {
+            sum += x[i];
+            lo_val = std::min(lo_val, x[i]);
+            hi_val = std::max(hi_val, x[i]);
+        }
+        block.count_ = n;
+        block.mean_ = sum / n;
+        for (size_t i = 0; i < n; ++i)
+            block.m2_ += (x[i] - block.mean_) * (x[i] - block.mean_);
+        block.min_ = lo_val;
+        block.max_ = hi_val;
+
+        merge(block);
+    }
+}
+
+void RunningStats::merge(const RunningStats& other) {
+    if (other.count_ == 0) return;
+    if (count_ == 0) {
+        *this = other;
+        return;
+    }
+
+    const double n_a = count_, n_b = other.count_, n = n_a + n_b;
+    const double delta = other.mean_ - mean_;
+    mean_ += delta * (n_b / n);
+    m2_ += other.m2_ + delta * delta * (n_a * n_b / n);
+    count_ += other.count_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+double RunningStats::variance() const {
+    assert(count_ >= 2);
+    return m2_ / (count_ - 1);
+}
+
+double RunningStats::standard_deviation() const {
+    return std::sqrt(variance());
+}
+
+// ---------------- RunningCovariance ----------------
+
+void RunningCovariance::push(double x, double y) {
+    ++count_;
+    const double dx = x - mean_x_;
+    mean_x_ += dx / count_;
+    const double dy = y - mean_y_;
+    mean_y_ += dy / count_;
+    m2_x_ += dx * (x - mean_x_);
+    m2_y_ += dy * (y - mean_y_);
+    c_xy_ += dx * (y - mean_y_);
+}
+
+void RunningCovariance::push(ConstVectorSpan xs, ConstVectorSpan ys) {
+    assert(xs.size() == ys.size());
+    for (size_t lo = 0; lo < xs.size(); lo += kBlock) {
+        const size_t n = std::min(kBlock, xs.size() - lo);
+        const double* x = xs.data() + lo;
+        const double* y = ys.data() + lo;
+
+        RunningCovariance block;
+        double sum_x = 0.0, sum_y = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            sum_x += x[i];
+            sum_y += y[i];
+        }
+        block.count_ = n;
+        block.mean_x_ = sum_x / n;
+        block.mean_y_ = sum_y / n;
+        for (size_t i = 0; i < n; ++i) {
+            const double dx = x[i] - block.mean_x_;
+            const double dy = y[i] - block.mean_y_;
+            block.m2_x_ += dx * dx;
+            block.m2_y_ += dy * dy;
+            block.c_xy_ += dx * dy;
+        }
+
+        merge(block);
+    }
+}
+
+void RunningCovariance::merge(const RunningCovariance& other) {
+    if (other.count_ == 0) return;
+    if (count_ == 0) {
+        *this = other;
+        return;
+    }
+
+    const double n_a = count_, n_b = other.count_, n = n_a + n_b;
+    const double dx = other.mean_x_ - mean_x_;
+    const double dy = other.mean_y_ - mean_y_;
+    const double w = n_a * n_b / n;
+    mean_x_ += dx * (n_b / n);
+    mean_y_ += dy * (n_b / n);
+    m2_x_ += other.m2_x_ + dx * dx * w;
+    m2_y_ += other.m2_y_ + dy * dy * w;
+    c_xy_ += other.c_xy_ + dx * dy * w;
+    count_ += other.count_;
+}
+
+double RunningCovariance::variance_x() const {
+    assert(count_ >= 2);
+    return m2_x_ / (count_ - 1);
+}
+
+double RunningCovariance::variance_y() const {
+    assert(count_ >= 2);
+    return m2_y_ / (count_ - 1);
+}
+
+double RunningCovariance::covariance() const {
+    assert(count_ >= 2);
+    return c_xy_ / (count_ - 1);
+}
+
+double RunningCovariance::correlation() const {
+    if (m2_x_ > 0 && m2_y_ > 0)
+        return c_xy_ / std::sqrt(m2_x_) / std::sqrt(m2_y_);
+    return 0;
+}
+
+} // namespace ds
@@ -0,0 +1,62 @@
+#include "ds/arena.hpp"
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+namespace ds {
+
+namespace {
+constexpr size_t kBlockAlignment = 64;
+
+size_t align_up(size_t offset, size_t alignment) {
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+} // namespace
+
+Arena::Arena(size_t block_size) : block_size_(std::max<size_t>(block_size, kBlockAlignment)) {}
+
+Arena::~Arena() {
+    for (const Block& b : blocks_)
+        ::operator delete(b.data, std::align_val_t(kBlockAlignment));
+}
+
+void Arena::rewind(Mark m) {
+    assert(m.block < current_ || (m.block == current_ && m.offset <= offset_));
+    current_ = m.block;
+    offset_ = m.offset;
+}
+
+size_t Arena::bytes_reserved() const {
+    size_t total = 0;
+    for (const Block& b : blocks_)
+        total += b.size;
+    return total;
+}
+
+void* Arena::do_allocate(size_t bytes, size_t alignment) {
+    assert(alignment <= kBlockAlignment && (alignment & (alignment - 1)) == 0);
+
+    // Bump within the current block, else move on to the next block that
+    // fits (blocks kept from before a rewind are reused first).
+    for (; current_ < blocks_.size(); ++current_, offset_ = 0) {
+        const size_t start = align_up(offset_, alignment);
+        if (start + bytes <= blocks_[current_].size) {
+            offset_ = start + bytes;
+            return blocks_[current_].data + start;
+        }
+    }
+
+    const size_t size = std::max(block_size_, align_up(bytes, kBlockAlignment));
+    auto* data = static_cast<std::byte*>(::operator new(size, std::align_val_t(kBlockAlignment)));
+    blocks_.push_back({data, size});
+    current_ = blocks_.size() - 1;
+    offset_ = bytes;
+    return data;
+}
+
+Arena& scratch_arena() {
+    thread_local Arena arena;
+    return arena;
+}
+
+} // namespace ds
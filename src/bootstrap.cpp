@@ -0,0 +1,225 @@
+#include "ds/bootstrap.hpp"
+#include "ds/parallel.hpp"
+#include "ds/probability.hpp"
+#include "ds/statistics.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace ds {
+namespace {
+
+// xoshiro256** (Blackman & Vigna), seeded through splitmix64
+class Xoshiro256 {
+public:
+    explicit Xoshiro256(uint64_t seed) {
+        for (uint64_t& word : s_) {
+            seed += 0x9e3779b97f4a7c15ull;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t next() {
+        const uint64_t result = rotl(s_[1] * 5, 7) * 9;
+        const uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl(s_[3], 45);
+        return result;
+    }
+
+    /// Uniform in [0, n) without modulo bias (Lemire's multiply-shift)
+    uint32_t below(uint32_t n) {
+        uint64_t m = (next() >> 32) * n;
+        uint32_t low = static_cast<uint32_t>(m);
+        if (low < n) {
+            const uint32_t threshold = static_cast<uint32_t>(-n) % n;
+            while (low < threshold) {
+                m = (next() >> 32) * n;
+                low = static_cast<uint32_t>(m);
+            }
+        }
+        return static_cast<uint32_t>(m >> 32);
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+    uint64_t s_[4];
+};
+
+constexpr uint32_t kDrawBlock = 1024;   // indices drawn before they are counted
+
+void draw_resample(uint64_t seed, size_t r, std::vector<uint32_t>& counts) {
+    Xoshiro256 rng(seed ^ (0xd1b54a32d192ed03ull * (r + 1)));
+    const uint32_t n = static_cast<uint32_t>(counts.size());
+    std::fill(counts.begin(), counts.end(), 0u);
+
+    // drawing a block first keeps the generator's dependency chain out of
+    // the scattered increments, so their cache misses overlap
+    uint32_t index[kDrawBlock];
+    for (size_t lo = 0; lo < n; lo += kDrawBlock) {   // size_t: lo + kDrawBlock may pass 2^32
+        const uint32_t m = static_cast<uint32_t>(std::min<size_t>(kDrawBlock, n - lo));
+        for (uint32_t i = 0; i < m; ++i) index[i] = rng.below(n);
+        for (uint32_t i = 0; i < m; ++i) ++counts[index[i]];
+    }
+}
+
+// BCa acceleration from a delete-a-group jackknife
+double acceleration(size_t n, const ResampleStatistic& statistic, size_t groups) {
+    groups = std::min(groups, n);
+    Vector theta(groups);
+    parallel_for(0, groups, 1, [&](size_t lo, size_t hi) {
+        std::vector<uint32_t> counts(n);
+        for (size_t g = lo; g < hi; ++g) {
+            for (size_t i = 0; i < n; ++i)
+                counts[i] = (i % groups == g) ? 0u : 1u;   // interleaved groups
+            theta[g] = statistic(ResampleCounts(counts.data(), n));
+        }
+    });
+
+    const double theta_bar = mean(theta);
+    double num = 0.0, den = 0.0;
+    for (double t : theta) {
+        const double d = theta_bar - t;
+        num += d * d * d;
+        den += d * d;
+    }
+    return den > 0.0 ? num / (6.0 * std::pow(den, 1.5)) : 0.0;
+}
+
+// Weighted moments of the resample
+struct Moments {
+    double n = 0.0, mean = 0.0, m2 = 0.0;
+};
+
+Moments weighted_moments(ConstVectorSpan xs, ResampleCounts counts) {
+    Moments m;
+    double sum = 0.0, total = 0.0;
+    for (size_t i = 0; i < xs.size(); ++i) {
+        sum += counts[i] * xs[i];
+        total += counts[i];
+    }
+    m.n = total;
+    m.mean = sum / total;
+    for (size_t i = 0; i < xs.size(); ++i) {
+        const double d = xs[i] - m.mean;
+        m.m2 += counts[i] * d * d;
+    }
+    return m;
+}
+
+} // namespace
+
+Vector bootstrap_replicates(size_t n, const ResampleStatistic& statistic,
+                            const BootstrapOptions& options) {
+    assert(n >= 1 && n <= std::numeric_limits<uint32_t>::max());
+    Vector replicates(options.resamples);
+    parallel_for(0, options.resamples, 1, [&](size_t lo, size_t hi) {
+        std::vector<uint32_t> counts(n);   // reused for every resample of the chunk
+        for (size_t r = lo; r < hi; ++r) {
+            draw_resample(options.seed, r, counts);
+            replicates[r] = statistic(ResampleCounts(counts.data(), n));
+        }
+    });
+    return replicates;
+}
+
+ConfidenceInterval bootstrap(size_t n, const ResampleStatistic& statistic,
+                             const BootstrapOptions& options) {
+    assert(options.resamples >= 2 && options.confidence > 0.0 && options.confidence < 1.0);
+    const std::vector<uint32_t> ones(n, 1u);
+    const double estimate = statistic(ResampleCounts(ones.data(), n));
+    const Vector replicates = bootstrap_replicates(n, statistic, options);
+
+    const double alpha = (1.0 - options.confidence) / 2.0;
+    double p_lo = alpha, p_hi = 1.0 - alpha;
+
+    if (options.method == IntervalMethod::BCa) {
+        // bias correction: how far the replicates sit below the estimate
+        const double B = static_cast<double>(replicates.size());
+        double below = 0.0;
+        for (double t : replicates)
+            below += t < estimate ? 1.0 : (t == estimate ? 0.5 : 0.0);
+        const double share = std::min(std::max(below / B, 1.0 / (B + 1.0)), B / (B + 1.0));
+        const double z0 = inverse_normal_cdf(share, 0.0, 1.0, 1e-10);
+        const double a = acceleration(n, statistic, options.jackknife_groups);
+
+        auto adjust = [&](double p) {
+            const double z = z0 + inverse_normal_cdf(p, 0.0, 1.0, 1e-10);
+            return normal_cdf(z0 + z / (1.0 - a * z));
+        };
+        p_lo = adjust(p_lo);
+        p_hi = adjust(p_hi);
+    }
+
+    const Vector bounds = quantiles(replicates, {p_lo, p_hi});
+    return {estimate, bounds[0], bounds[1]};
+}
+
+ConfidenceInterval bootstrap_mean(ConstVectorSpan xs, const BootstrapOptions& options) {
+    return bootstrap(xs.size(), [xs](ResampleCounts counts) {
+        double sum = 0.0, total = 0.0;
+        for (size_t i = 0; i < xs.size(); ++i) {
+            sum += counts[i] * xs[i];
+            total += counts[i];
+        }
+        return sum / total;
+    }, options);
+}
+
+ConfidenceInterval bootstrap_standard_deviation(ConstVectorSpan xs, const BootstrapOptions& options) {
+    assert(xs.size() >= 2);
+    return bootstrap(xs.size(), [xs](ResampleCounts counts) {
+        const Moments m = weighted_moments(xs, counts);
+        return std::sqrt(m.m2 / (m.n - 1.0));
+    }, options);
+}
+
+ConfidenceInterval bootstrap_median(ConstVectorSpan xs, const BootstrapOptions& options) {
+    // Resampling picks positions uniformly, so it can just as well pick
+    // them from a sorted copy; the median of a resample is then found by
+    // walking the cumulative counts
+    Vector sorted(xs.begin(), xs.end());
+    std::sort(sorted.begin(), sorted.end());
+    return bootstrap(sorted.size(), [&sorted](ResampleCounts counts) {
+        uint64_t total = 0;
+        for (uint32_t c : counts) total += c;
+        const uint64_t hi_rank = total / 2;                          // as median()
+        const uint64_t lo_rank = total % 2 == 1 ? hi_rank : hi_rank - 1;
+
+        double lo_value = 0.0;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            if (counts[i] == 0) continue;
+            if (seen <= lo_rank && lo_rank < seen + counts[i]) lo_value = sorted[i];
+            seen += counts[i];
+            if (seen > hi_rank) return (lo_value + sorted[i]) / 2.0;
+        }
+        return sorted.back();
+    }, options);
+}
+
+ConfidenceInterval bootstrap_correlation(ConstVectorSpan xs, ConstVectorSpan ys,
+                                         const BootstrapOptions& options) {
+    assert(xs.size() == ys.size());
+    return bootstrap(xs.size(), [xs, ys](ResampleCounts counts) {
+        const Moments mx = weighted_moments(xs, counts);
+        const Moments my = weighted_moments(ys, counts);
+        double c_xy = 0.0;
+        for (size_t i = 0; i < xs.size(); ++i)
+            c_xy += counts[i] * (xs[i] - mx.mean) * (ys[i] - my.mean);
+        if (mx.m2 > 0 && my.m2 > 0)
+            return c_xy / std::sqrt(mx.m2) / std::sqrt(my.m2);
+        return 0.0;   // as correlation()
+    }, options);
+}
+
+} // namespace ds
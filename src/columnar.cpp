@@ -0,0 +1,307 @@
+#include "ds/columnar.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DS_HAVE_MMAP 1
+#endif
+
+namespace ds {
+namespace {
+
+constexpr char kMagic[8] = {'D', 'S', 'C', 'O', 'L', '\0', '\0', '\1'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kAlign = 64;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t num_columns;
+    uint64_t rows;
+    uint64_t chunk_rows;
+    char reserved[32];
+};
+static_assert(sizeof(FileHeader) == 64, "header must stay 64 bytes");
+
+struct DirectoryEntry {
+    uint64_t name_offset;
+    uint32_t name_length;
+    uint32_t type;
+    uint64_t data_offset;
+    uint64_t stats_offset;   // 0: no chunk statistics
+};
+static_assert(sizeof(DirectoryEntry) == 32, "directory entries must stay 32 bytes");
+
+size_t align_up(size_t offset) {
+    return (offset + kAlign - 1) / kAlign * kAlign;
+}
+
+size_t element_size(ColumnType type) {
+    return type == ColumnType::Float32 ? sizeof(float) : sizeof(double);
+}
+
+template<typename T>
+std::vector<ChunkStats> compute_chunk_stats(const T* values, size_t rows, size_t chunk_rows) {
+    std::vector<ChunkStats> stats;
+    for (size_t lo = 0; lo < rows; lo += chunk_rows) {
+        const size_t hi = std::min(rows, lo + chunk_rows);
+        ChunkStats s{double(values[lo]), double(values[lo]), 0.0};
+        for (size_t i = lo; i < hi; ++i) {
+            const double v = values[i];
+            s.min = std::min(s.min, v);
+            s.max = std::max(s.max, v);
+            s.sum += v;
+        }
+        stats.push_back(s);
+    }
+    return stats;
+}
+
+[[noreturn]] void invalid(const std::string& path, const char* why) {
+    throw std::runtime_error("columnar file " + path + ": " + why);
+}
+
+} // namespace
+
+// ---------------- ColumnarWriter ----------------
+
+ColumnarWriter::ColumnarWriter(size_t chunk_rows, bool chunk_stats)
+    : chunk_rows_(chunk_rows), chunk_stats_(chunk_stats) {
+    assert(chunk_rows >= 1);
+}
+
+void ColumnarWriter::add_column(const std::string& name, ConstVectorSpan values) {
+    assert(columns_.empty() || values.size() == rows_);
+    rows_ = values.size();
+    columns_.push_back({name, ColumnType::Float64, values.data()});
+}
+
+void ColumnarWriter::add_column(const std::string& name, ConstFloatSpan values) {
+    assert(columns_.empty() || values.size() == rows_);
+    rows_ = values.size();
+    columns_.push_back({name, ColumnType::Float32, values.data()});
+}
+
+void ColumnarWriter::write(const std::string& path) const {
+    const size_t k = columns_.size();
+    const size_t chunks = (rows_ + chunk_rows_ - 1) / chunk_rows_;
+
+    // Lay out the sections
+    std::vector<DirectoryEntry> directory(k);
+    size_t offset = sizeof(FileHeader) + k * sizeof(DirectoryEntry);
+    for (size_t c = 0; c < k; ++c) {
+        directory[c].name_offset = offset;
+        directory[c].name_length = static_cast<uint32_t>(columns_[c].name.size());
+        directory[c].type = static_cast<uint32_t>(columns_[c].type);
+        offset += columns_[c].name.size();
+    }
+    for (size_t c = 0; c < k; ++c) {
+        offset = align_up(offset);
+        directory[c].data_offset = offset;
+        offset += rows_ * element_size(columns_[c].type);
+    }
+    for (size_t c = 0; c < k; ++c) {
+        if (!chunk_stats_ || rows_ == 0) {
+            directory[c].stats_offset = 0;
+            continue;
+        }
+        offset = align_up(offset);
+        directory[c].stats_offset = offset;
+        offset += chunks * sizeof(ChunkStats);
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) invalid(path, "cannot open for writing");
+
+    size_t written = 0;
+    auto put = [&](const void* data, size_t bytes) {
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        written += bytes;
+    };
+    auto pad_to = [&](size_t target) {
+        static const char zeros[kAlign] = {};
+        assert(target >= written && target - written < kAlign);
+        put(zeros, target - written);
+    };
+
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof kMagic);
+    header.version = kVersion;
+    header.num_columns = static_cast<uint32_t>(k);
+    header.rows = rows_;
+    header.chunk_rows = chunk_rows_;
+    put(&header, sizeof header);
+    put(directory.data(), k * sizeof(DirectoryEntry));
+    for (const Column& column : columns_)
+        put(column.name.data(), column.name.size());
+
+    for (size_t c = 0; c < k; ++c) {
+        pad_to(directory[c].data_offset);
+        put(columns_[c].data, rows_ * element_size(columns_[c].type));
+    }
+    for (size_t c = 0; c < k; ++c) {
+        if (directory[c].stats_offset == 0) continue;
+        pad_to(directory[c].stats_offset);
+        const std::vector<ChunkStats> stats = columns_[c].type == ColumnType::Float32
+            ? compute_chunk_stats(static_cast<const float*>(columns_[c].data), rows_, chunk_rows_)
+            : compute_chunk_stats(static_cast<const double*>(columns_[c].data), rows_, chunk_rows_);
+        put(stats.data(), stats.size() * sizeof(ChunkStats));
+    }
+
+    out.close();
+    if (!out) invalid(path, "write failed");
+}
+
+// ---------------- ColumnarFile ----------------
+
+ColumnarFile::ColumnarFile(const std::string& path) {
+#if defined(DS_HAVE_MMAP)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) invalid(path, "cannot open");
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        invalid(path, "cannot stat");
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ > 0) {
+        void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            invalid(path, "mmap failed");
+        }
+        base_ = static_cast<const unsigned char*>(p);
+        mapped_ = true;
+    }
+    ::close(fd);   // the mapping stays valid
+#else
+    // No mmap: read the whole file into a 64-byte aligned buffer instead
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) invalid(path, "cannot open");
+    size_ = static_cast<size_t>(in.tellg());
+    unsigned char* buffer = static_cast<unsigned char*>(::operator new(size_, std::align_val_t(kAlign)));
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(buffer), static_cast<std::streamsize>(size_));
+    base_ = buffer;
+    if (!in) {
+        release();
+        invalid(path, "read failed");
+    }
+#endif
+
+    // Validate everything the accessors will touch, so they need no checks
+    try {
+        FileHeader header;
+        if (size_ < sizeof header) invalid(path, "truncated header");
+        std::memcpy(&header, base_, sizeof header);
+        if (std::memcmp(header.magic, kMagic, sizeof kMagic) != 0) invalid(path, "not a columnar file");
+        if (header.version != kVersion) invalid(path, "unsupported version");
+        if (header.chunk_rows == 0) invalid(path, "bad chunk size");
+
+        rows_ = header.rows;
+        chunk_rows_ = header.chunk_rows;
+        const size_t k = header.num_columns;
+        if ((size_ - sizeof header) / sizeof(DirectoryEntry) < k) invalid(path, "truncated directory");
+
+        columns_.resize(k);
+        for (size_t c = 0; c < k; ++c) {
+            DirectoryEntry entry;
+            std::memcpy(&entry, base_ + sizeof header + c * sizeof entry, sizeof entry);
+            if (entry.type > static_cast<uint32_t>(ColumnType::Float32)) invalid(path, "unknown column type");
+            const ColumnType type = static_cast<ColumnType>(entry.type);
+
+            auto fits = [&](uint64_t at, uint64_t count, uint64_t bytes_each) {
+                return at <= size_ && count <= (size_ - at) / bytes_each;
+            };
+            if (!fits(entry.name_offset, entry.name_length, 1)) invalid(path, "truncated column name");
+            if (entry.data_offset % kAlign != 0 || !fits(entry.data_offset, rows_, element_size(type)))
+                invalid(path, "truncated column data");
+            if (entry.stats_offset != 0 &&
+                (entry.stats_offset % kAlign != 0 || !fits(entry.stats_offset, num_chunks(), sizeof(ChunkStats))))
+                invalid(path, "truncated chunk statistics");
+
+            Column& column = columns_[c];
+            column.name.assign(reinterpret_cast<const char*>(base_ + entry.name_offset), entry.name_length);
+            column.type = type;
+            column.data = base_ + entry.data_offset;
+            column.stats = entry.stats_offset != 0
+                ? reinterpret_cast<const ChunkStats*>(base_ + entry.stats_offset) : nullptr;
+        }
+    } catch (...) {
+        release();
+        throw;
+    }
+}
+
+ColumnarFile::~ColumnarFile() {
+    release();
+}
+
+ColumnarFile::ColumnarFile(ColumnarFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+ColumnarFile& ColumnarFile::operator=(ColumnarFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        base_ = std::exchange(other.base_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        mapped_ = std::exchange(other.mapped_, false);
+        rows_ = std::exchange(other.rows_, 0);
+        chunk_rows_ = std::exchange(other.chunk_rows_, 1);
+        columns_ = std::move(other.columns_);
+        other.columns_.clear();
+    }
+    return *this;
+}
+
+void ColumnarFile::release() noexcept {
+    if (base_ == nullptr) return;
+#if defined(DS_HAVE_MMAP)
+    if (mapped_) ::munmap(const_cast<unsigned char*>(base_), size_);
+#else
+    ::operator delete(const_cast<unsigned char*>(base_), std::align_val_t(kAlign));
+#endif
+    base_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+}
+
+size_t ColumnarFile::find(const std::string& name) const {
+    for (size_t c = 0; c < columns_.size(); ++c)
+        if (columns_[c].name == name) return c;
+    return columns_.size();
+}
+
+// The type comes from the file, so a mismatch is a runtime error, not a
+// programming one: a Float32 column read as doubles would run past its data
+ConstVectorSpan ColumnarFile::column(size_t c) const {
+    assert(c < columns_.size());
+    if (columns_[c].type != ColumnType::Float64)
+        throw std::runtime_error("columnar column " + columns_[c].name + " is not Float64");
+    return ConstVectorSpan(reinterpret_cast<const double*>(columns_[c].data), rows_);
+}
+
+ConstFloatSpan ColumnarFile::float_column(size_t c) const {
+    assert(c < columns_.size());
+    if (columns_[c].type != ColumnType::Float32)
+        throw std::runtime_error("columnar column " + columns_[c].name + " is not Float32");
+    return ConstFloatSpan(reinterpret_cast<const float*>(columns_[c].data), rows_);
+}
+
+Span<const ChunkStats> ColumnarFile::chunk_stats(size_t c) const {
+    assert(c < columns_.size());
+    if (columns_[c].stats == nullptr) return {};
+    return Span<const ChunkStats>(columns_[c].stats, num_chunks());
+}
+
+} // namespace ds
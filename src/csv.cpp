@@ -0,0 +1,227 @@
+#include "ds/csv.hpp"
+#include "ds/parallel.hpp"
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace ds {
+namespace {
+
+constexpr size_t kMinPieceBytes = size_t(1) << 18;   // text per parsing task
+
+[[noreturn]] void malformed(size_t row, const char* why) {
+    throw std::runtime_error("csv: data row " + std::to_string(row + 1) + ": " + why);
+}
+
+// Line starting at pos without its "\n" / "\r\n"; pos moves past it
+std::string_view next_line(std::string_view text, size_t& pos) {
+    const size_t start = pos;
+    size_t end = text.find('\n', start);
+    if (end == std::string_view::npos) end = text.size();
+    pos = end < text.size() ? end + 1 : end;
+    if (end > start && text[end - 1] == '\r') --end;
+    return text.substr(start, end - start);
+}
+
+bool is_blank(std::string_view line) {
+    for (char ch : line)
+        if (ch != ' ' && ch != '\t') return false;
+    return true;
+}
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) s.remove_suffix(1);
+    return s;
+}
+
+std::vector<std::string_view> split(std::string_view line, char delimiter) {
+    std::vector<std::string_view> fields;
+    for (size_t start = 0;;) {
+        const size_t end = line.find(delimiter, start);
+        fields.push_back(trim(line.substr(start, end - start)));
+        if (end == std::string_view::npos) return fields;
+        start = end + 1;
+    }
+}
+
+bool parse_field(std::string_view field, double& out) {
+    field = trim(field);
+    if (field.empty()) {
+        out = std::numeric_limits<double>::quiet_NaN();
+        return true;
+    }
+    if (field.front() == '+') field.remove_prefix(1);
+    const char* end = field.data() + field.size();
+    const auto [ptr, ec] = std::from_chars(field.data(), end, out);
+    return ec == std::errc() && ptr == end;
+}
+
+// Parse one record into row `row` of every column
+void parse_record(std::string_view line, char delimiter, std::vector<Vector>& columns,
+                  size_t row, size_t row_number) {
+    const char* p = line.data();
+    const char* const end = p + line.size();
+    for (size_t c = 0; c < columns.size(); ++c) {
+        const char* stop = static_cast<const char*>(std::memchr(p, delimiter, end - p));
+        const bool last = c + 1 == columns.size();
+        if (stop == nullptr) {
+            if (!last) malformed(row_number, "too few fields");
+            stop = end;
+        } else if (last) {
+            malformed(row_number, "too many fields");
+        }
+        if (!parse_field(std::string_view(p, stop - p), columns[c][row]))
+            malformed(row_number, "field is not a number");
+        p = stop + 1;
+    }
+}
+
+// Parse every record of text into columns (resized to the record count),
+// in parallel. first_row numbers the rows in error messages.
+// @return Number of records
+size_t parse_records(std::string_view text, const CsvOptions& options,
+                     std::vector<Vector>& columns, size_t first_row) {
+    // Split at record boundaries: each cut moves to just after a newline
+    const size_t pieces = chunk_count(text.size(), kMinPieceBytes);
+    std::vector<size_t> bounds(pieces + 1, text.size());
+    bounds[0] = 0;
+    for (size_t i = 1; i < pieces; ++i) {
+        size_t cut = std::max(bounds[i - 1], i * text.size() / pieces);
+        if (cut > 0 && text[cut - 1] != '\n') {
+            const size_t nl = text.find('\n', cut);
+            cut = nl == std::string_view::npos ? text.size() : nl + 1;
+        }
+        bounds[i] = cut;
+    }
+
+    auto for_each_record = [&](size_t piece, auto&& fn) {
+        const std::string_view part = text.substr(bounds[piece], bounds[piece + 1] - bounds[piece]);
+        for (size_t pos = 0; pos < part.size();) {
+            const std::string_view line = next_line(part, pos);
+            if (!is_blank(line)) fn(line);
+        }
+    };
+
+    // Count, allocate once, then parse each piece into its own rows
+    std::vector<size_t> offsets(pieces + 1, 0);
+    parallel_for_chunks(pieces, [&](size_t i) {
+        size_t count = 0;
+        for_each_record(i, [&](std::string_view) { ++count; });
+        offsets[i + 1] = count;
+    });
+    for (size_t i = 0; i < pieces; ++i)
+        offsets[i + 1] += offsets[i];
+
+    for (Vector& column : columns)
+        column.resize(offsets[pieces]);
+
+    parallel_for_chunks(pieces, [&](size_t i) {
+        size_t row = offsets[i];
+        for_each_record(i, [&](std::string_view line) {
+            parse_record(line, options.delimiter, columns, row, first_row + row);
+            ++row;
+        });
+    });
+    return offsets[pieces];
+}
+
+// Column names from the first non-blank record (or "0", "1", ... when
+// there is no header); pos moves past the header
+std::vector<std::string> read_names(std::string_view text, size_t& pos, const CsvOptions& options) {
+    std::string_view line;
+    size_t after = pos;
+    do {
+        if (after >= text.size()) return {};
+        line = next_line(text, after);
+    } while (is_blank(line));
+
+    const std::vector<std::string_view> fields = split(line, options.delimiter);
+    std::vector<std::string> names;
+    for (size_t c = 0; c < fields.size(); ++c)
+        names.push_back(options.header ? std::string(fields[c]) : std::to_string(c));
+    if (options.header) pos = after;
+    return names;
+}
+
+} // namespace
+
+CsvTable parse_csv(std::string_view text, const CsvOptions& options) {
+    CsvTable table;
+    size_t pos = 0;
+    table.names = read_names(text, pos, options);
+    table.columns.resize(table.names.size());
+    if (!table.columns.empty())
+        parse_records(text.substr(pos), options, table.columns, 0);
+    return table;
+}
+
+CsvTable read_csv(const std::string& path, const CsvOptions& options) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) throw std::runtime_error("csv: cannot open " + path);
+    std::string text(static_cast<size_t>(in.tellg()), '\0');
+    in.seekg(0);
+    in.read(&text[0], static_cast<std::streamsize>(text.size()));
+    if (!in) throw std::runtime_error("csv: cannot read " + path);
+    return parse_csv(text, options);
+}
+
+// ---------------- CsvReader ----------------
+
+CsvReader::CsvReader(const std::string& path, const CsvOptions& options)
+    : in_(path, std::ios::binary), options_(options) {
+    if (!in_) throw std::runtime_error("csv: cannot open " + path);
+
+    // Read until the first non-blank record is complete: read_names skips
+    // blank lines, so the first '\n' may only end one of those
+    size_t scanned = 0;
+    for (;;) {
+        const size_t newline = buffer_.find('\n', scanned);
+        if (newline == std::string::npos) {
+            if (!fill()) break;
+            continue;
+        }
+        std::string_view line(buffer_.data() + scanned, newline - scanned);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (!is_blank(line)) break;
+        scanned = newline + 1;
+    }
+    size_t pos = 0;
+    names_ = read_names(buffer_, pos, options_);
+    buffer_.erase(0, pos);
+}
+
+bool CsvReader::fill() {
+    const size_t old = buffer_.size();
+    buffer_.resize(old + options_.chunk_bytes);
+    in_.read(&buffer_[old], static_cast<std::streamsize>(options_.chunk_bytes));
+    buffer_.resize(old + static_cast<size_t>(in_.gcount()));
+    return in_.gcount() > 0;
+}
+
+bool CsvReader::next(std::vector<Vector>& columns) {
+    columns.resize(names_.size());
+    if (names_.empty()) return false;
+
+    for (;;) {
+        const bool more = fill();
+        if (!more && buffer_.empty()) return false;
+
+        // Parse up to the last complete record; at the end, everything
+        size_t end = buffer_.size();
+        if (more) {
+            end = buffer_.rfind('\n');
+            if (end == std::string::npos) continue;   // a record longer than a chunk
+            ++end;
+        }
+        const size_t rows = parse_records(std::string_view(buffer_.data(), end), options_,
+                                          columns, rows_read_);
+        buffer_.erase(0, end);
+        rows_read_ += rows;
+        if (rows > 0) return true;
+        if (!more) return false;
+    }
+}
+
+} // namespace ds
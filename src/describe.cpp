@@ -0,0 +1,146 @@
+#include "ds/describe.hpp"
+#include "ds/accumulators.hpp"
+#include "ds/arena.hpp"
+#include "ds/parallel.hpp"
+#include "ds/sketches.hpp"
+#include "ds/statistics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ds {
+namespace {
+
+constexpr size_t kBlock = 2048;          // values fed to every summary at a time (L1)
+constexpr size_t kChunk = size_t(1) << 16;   // values per parallel task
+constexpr size_t kRowBlock = 256;        // table rows transposed at a time
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+// Partial summary of one chunk of one column
+struct Partial {
+    RunningStats stats;
+    QuantileSketch sketch;
+
+    explicit Partial(size_t k) : sketch(k) {}
+
+    void push(ConstVectorSpan block, bool with_sketch) {
+        stats.push(block);
+        if (with_sketch) sketch.push(block);
+    }
+
+    void merge(const Partial& other, bool with_sketch) {
+        stats.merge(other.stats);
+        if (with_sketch) sketch.merge(other.sketch);
+    }
+};
+
+ColumnSummary finish(const Partial& p, const DescribeOptions& options) {
+    ColumnSummary s;
+    const RunningStats& st = p.stats;
+    s.count = st.count();
+    s.mean = s.count > 0 ? st.mean() : kNaN;
+    s.min = s.count > 0 ? st.min() : kNaN;
+    s.max = s.count > 0 ? st.max() : kNaN;
+    s.variance = s.count > 1 ? st.variance() : kNaN;
+    s.standard_deviation = std::sqrt(s.variance);
+    if (s.count == 0)
+        s.quantiles.assign(options.percentiles.size(), kNaN);
+    else if (!options.exact_quantiles)
+        s.quantiles = p.sketch.quantiles(options.percentiles);
+    return s;
+}
+
+} // namespace
+
+std::vector<ColumnSummary> describe(const std::vector<ConstVectorSpan>& columns,
+                                    const DescribeOptions& options) {
+    const bool sketch = !options.exact_quantiles;
+
+    // One task per chunk of a column, so long columns are split and short
+    // ones are handed out whole
+    struct Task { size_t column, lo, hi; };
+    std::vector<Task> tasks;
+    for (size_t c = 0; c < columns.size(); ++c) {
+        const size_t n = columns[c].size();
+        const size_t pieces = std::max<size_t>(1, n / kChunk);
+        for (size_t i = 0; i < pieces; ++i) {
+            const auto range = chunk_range(n, pieces, i);
+            tasks.push_back({c, range.first, range.second});
+        }
+    }
+
+    std::vector<Partial> partials(tasks.size(), Partial(options.sketch_k));
+    parallel_for_chunks(tasks.size(), [&](size_t t) {
+        const Task& task = tasks[t];
+        const ConstVectorSpan column = columns[task.column];
+        for (size_t lo = task.lo; lo < task.hi; lo += kBlock)
+            partials[t].push(column.subspan(lo, std::min(kBlock, task.hi - lo)), sketch);
+    });
+
+    // Chunks of a column are consecutive tasks: fold them in order
+    std::vector<Partial> merged(columns.size(), Partial(options.sketch_k));
+    for (size_t t = 0; t < tasks.size(); ++t)
+        merged[tasks[t].column].merge(partials[t], sketch);
+
+    std::vector<ColumnSummary> summaries(columns.size());
+    parallel_for_chunks(columns.size(), [&](size_t c) {
+        summaries[c] = finish(merged[c], options);
+        if (options.exact_quantiles && !columns[c].empty())
+            summaries[c].quantiles = quantiles(columns[c], options.percentiles);
+    });
+    return summaries;
+}
+
+std::vector<ColumnSummary> describe(const std::vector<Vector>& columns,
+                                    const DescribeOptions& options) {
+    std::vector<ConstVectorSpan> spans(columns.begin(), columns.end());
+    return describe(spans, options);
+}
+
+std::vector<ColumnSummary> describe(ConstMatrixView table, const DescribeOptions& options) {
+    const bool sketch = !options.exact_quantiles;
+    const size_t rows = table.rows(), cols = table.cols();
+
+    // Row chunks in parallel; within a chunk, blocks of rows are transposed
+    // so every column's summaries are fed contiguous values
+    const size_t min_rows = std::max<size_t>(kRowBlock, kChunk / std::max<size_t>(1, cols));
+    const size_t chunks = chunk_count(rows, min_rows);
+    std::vector<std::vector<Partial>> partials(chunks,
+        std::vector<Partial>(cols, Partial(options.sketch_k)));
+
+    parallel_for_chunks(chunks, [&](size_t chunk) {
+        const auto range = chunk_range(rows, chunks, chunk);
+        ScratchScope scope;
+        ScratchVector buffer = make_scratch(cols * kRowBlock);
+        for (size_t r0 = range.first; r0 < range.second; r0 += kRowBlock) {
+            const size_t nb = std::min(kRowBlock, range.second - r0);
+            for (size_t r = 0; r < nb; ++r) {
+                const double* row = &table(r0 + r, 0);
+                for (size_t c = 0; c < cols; ++c)
+                    buffer[c * nb + r] = row[c];
+            }
+            for (size_t c = 0; c < cols; ++c)
+                partials[chunk][c].push(ConstVectorSpan(buffer.data() + c * nb, nb), sketch);
+        }
+    });
+
+    for (size_t chunk = 1; chunk < chunks; ++chunk)
+        for (size_t c = 0; c < cols; ++c)
+            partials[0][c].merge(partials[chunk][c], sketch);
+
+    std::vector<ColumnSummary> summaries(cols);
+    parallel_for_chunks(cols, [&](size_t c) {
+        summaries[c] = finish(partials[0][c], options);
+        if (options.exact_quantiles && rows > 0) {
+            ScratchScope scope;
+            ScratchVector column = make_scratch(rows);
+            for (size_t r = 0; r < rows; ++r)
+                column[r] = table(r, c);
+            summaries[c].quantiles = quantiles(ConstVectorSpan(column.data(), rows), options.percentiles);
+        }
+    });
+    return summaries;
+}
+
+} // namespace ds
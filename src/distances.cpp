@@ -0,0 +1,129 @@
+#include "ds/distances.hpp"
+#include "ds/parallel.hpp"
+#include "simd_kernels.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace ds {
+namespace {
+
+// Tile of the distance matrix handled at once in pairwise_top_k: 64 query
+// rows x 1024 reference columns = 512 KiB of doubles, sized for L2.
+constexpr size_t kRowTile = 64;
+constexpr size_t kColTile = 1024;
+
+// Heap order: "a is nearer than b", ties broken by index so results are
+// deterministic.
+bool nearer(const Neighbor& a, const Neighbor& b) {
+    if (a.squared_distance != b.squared_distance)
+        return a.squared_distance < b.squared_distance;
+    return a.index < b.index;
+}
+
+DenseMatrix transposed(ConstMatrixView B) {
+    DenseMatrix Bt(B.cols(), B.rows());
+    transpose(B, Bt);
+    return Bt;
+}
+
+} // namespace
+
+Vector row_squared_norms(ConstMatrixView A) {
+    Vector norms(A.rows());
+    const auto& k = simd::kernels();
+    parallel_for(0, A.rows(), 256, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i)
+            norms[i] = k.sum_of_squares(A.row(i).data(), A.cols());
+    });
+    return norms;
+}
+
+void pairwise_squared_distances(ConstMatrixView A, ConstMatrixView B, MatrixView D) {
+    assert(A.cols() == B.cols());
+    assert(D.rows() == A.rows() && D.cols() == B.rows());
+
+    const Vector na = row_squared_norms(A);
+    const Vector nb = row_squared_norms(B);
+
+    // D = -2 A B^T, then add the norms in a second, cache-friendly sweep
+    gemm(-2.0, A, transposed(B), 0.0, D);
+
+    parallel_for(0, D.rows(), 64, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            auto row = D.row(i);
+            for (size_t j = 0; j < row.size(); ++j) {
+                const double d = row[j] + na[i] + nb[j];
+                row[j] = d < 0.0 ? 0.0 : d;   // clamp rounding, let NaN through
+            }
+        }
+    });
+}
+
+DenseMatrix pairwise_squared_distances(const DenseMatrix& A, const DenseMatrix& B) {
+    DenseMatrix D(A.rows(), B.rows());
+    pairwise_squared_distances(A, B, D);
+    return D;
+}
+
+Matrix pairwise_squared_distances(const Matrix& A, const Matrix& B) {
+    return to_nested(pairwise_squared_distances(to_dense(A), to_dense(B)));
+}
+
+std::vector<std::vector<Neighbor>> pairwise_top_k(ConstMatrixView A, ConstMatrixView B, size_t k) {
+    assert(A.cols() == B.cols());
+
+    const size_t n = A.rows();
+    const size_t m = B.rows();
+    k = std::min(k, m);
+
+    std::vector<std::vector<Neighbor>> result(n);
+    if (n == 0 || k == 0) return result;
+
+    const Vector na = row_squared_norms(A);
+    const Vector nb = row_squared_norms(B);
+    const DenseMatrix Bt = transposed(B);
+    const size_t row_blocks = (n + kRowTile - 1) / kRowTile;
+
+    parallel_for(0, row_blocks, 1, [&](size_t lo, size_t hi) {
+        DenseMatrix tile(kRowTile, kColTile);
+
+        for (size_t blk = lo; blk < hi; ++blk) {
+            const size_t r0 = blk * kRowTile;
+            const size_t rows = std::min(kRowTile, n - r0);
+
+            for (size_t r = 0; r < rows; ++r)
+                result[r0 + r].reserve(k);
+
+            for (size_t c0 = 0; c0 < m; c0 += kColTile) {
+                const size_t cols = std::min(kColTile, m - c0);
+                MatrixView T = tile.block(0, 0, rows, cols);
+                gemm(-2.0, A.block(r0, 0, rows, A.cols()), Bt.block(0, c0, Bt.rows(), cols), 0.0, T);
+
+                for (size_t r = 0; r < rows; ++r) {
+                    auto& heap = result[r0 + r];   // max-heap on `nearer`
+                    const double norm_a = na[r0 + r];
+                    for (size_t c = 0; c < cols; ++c) {
+                        const double d = T(r, c) + norm_a + nb[c0 + c];
+                        if (d != d) continue;   // NaN coordinates: never a neighbour
+                        Neighbor cand{c0 + c, d < 0.0 ? 0.0 : d};
+                        if (heap.size() < k) {
+                            heap.push_back(cand);
+                            std::push_heap(heap.begin(), heap.end(), nearer);
+                        } else if (nearer(cand, heap.front())) {
+                            std::pop_heap(heap.begin(), heap.end(), nearer);
+                            heap.back() = cand;
+                            std::push_heap(heap.begin(), heap.end(), nearer);
+                        }
+                    }
+                }
+            }
+
+            for (size_t r = 0; r < rows; ++r)
+                std::sort_heap(result[r0 + r].begin(), result[r0 + r].end(), nearer);
+        }
+    });
+
+    return result;
+}
+
+} // namespace ds
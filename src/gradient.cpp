@@ -3,6 +3,7 @@
 #include <cassert>
 #include <random>
 #include "ds/linear_algebra.hpp"
+#include "ds/sparse.hpp"
 
 namespace ds {
 
@@ -10,9 +11,7 @@ namespace ds {
 // Basic gradient-related helper functions
 // ────────────────────────────────────────────────
 
-double sum_of_squares(const Vector& v) {
-    return dot(v, v);
-}
+// sum_of_squares(const Vector&) is defined alongside dot() in linear_algebra.cpp
 
 double difference_quotient(std::function<double(double)> f, double x, double h = 0.0001) {
     return (f(x + h) - f(x)) / h;
@@ -43,9 +42,16 @@ Vector estimate_gradient(
     const Vector& v,
     double h = 0.0001)
 {
+    // One working copy for all coordinates (perturbed and restored in
+    // place) and one evaluation of f(v), instead of a copy and two calls
+    // per partial_difference_quotient.
     Vector grad(v.size());
+    Vector w = v;
+    const double fv = f(v);
     for (size_t i = 0; i < v.size(); ++i) {
-        grad[i] = partial_difference_quotient(f, v, i, h);
+        w[i] += h;
+        grad[i] = (f(w) - fv) / h;
+        w[i] = v[i];
     }
     return grad;
 }
@@ -62,12 +68,20 @@ Vector gradient_step(
     assert(v.size() == gradient.size());
 
     // Note: step_size is usually negative when doing descent
-    auto step = scalar_multiply(step_size, gradient);
-    return add(v, step);
+    return v + step_size * gradient;   // one fused loop, one allocation
+}
+
+void gradient_step_inplace(
+    VectorSpan v,
+    ConstVectorSpan gradient,
+    double step_size)
+{
+    assert(v.size() == gradient.size());
+    axpy(step_size, gradient, v);   // no allocation
 }
 
 Vector sum_of_squares_gradient(const Vector& v) {
-    return scalar_multiply(2.0, v);
+    return 2.0 * v;
 }
 
 // ────────────────────────────────────────────────
@@ -90,6 +104,53 @@ Vector linear_gradient(double x, double y, const Vector& theta) {
     };
 }
 
+void linear_gradient_into(double x, double y, ConstVectorSpan theta, VectorSpan grad) {
+    assert(theta.size() == 2 && grad.size() == 2);
+
+    double error = (theta[0] * x + theta[1]) - y;
+    grad[0] = 2 * error * x;
+    grad[1] = 2 * error;
+}
+
+// ────────────────────────────────────────────────
+// Sparse features
+// ────────────────────────────────────────────────
+
+void gradient_step_inplace(
+    VectorSpan v,
+    SparseView gradient,
+    double step_size)
+{
+    assert(v.size() == gradient.dim);
+    axpy(step_size, gradient, v);   // touches only the non-zeros
+}
+
+Vector gradient_step(
+    const Vector& v,
+    const SparseVector& gradient,
+    double step_size)
+{
+    Vector result = v;
+    gradient_step_inplace(result, gradient, step_size);
+    return result;
+}
+
+SparseVector linear_gradient(const SparseVector& x, double y, const Vector& theta) {
+    assert(x.dim() == theta.size());
+    double error = dot(x, theta) - y;
+    return scalar_multiply(2 * error, x);
+}
+
+Vector least_squares_gradient(const CsrMatrix& X, const Vector& y, const Vector& theta) {
+    assert(X.rows() == y.size() && X.cols() == theta.size() && X.rows() > 0);
+
+    Vector residual = y;
+    gemv(1.0, X, theta, -1.0, residual);   // X theta - y
+    Vector grad = matvec_transpose(X, residual);
+    scal(2.0 / X.rows(), grad);
+    return grad;
+}
+
 // ────────────────────────────────────────────────
 // Minibatch helper
 // ────────────────────────────────────────────────
@@ -0,0 +1,233 @@
+#include "ds/histogram.hpp"
+#include "ds/statistics.hpp"
+#include "simd_kernels.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace ds {
+namespace {
+
+constexpr size_t kBlock = 1024;                       // values binned per kernel call
+constexpr size_t kMinParallelChunk = size_t(1) << 15;
+
+} // namespace
+
+Histogram::Histogram(Kind kind, Vector edges)
+    : kind_(kind), edges_(std::move(edges)), lo_(0.0), hi_(0.0), scale_(0.0) {
+    // slots are uint32, and the SIMD kernels convert them through signed int32
+    assert(edges_.size() >= 2 && bins() <= size_t(INT32_MAX) - 2);
+    slots_.assign(bins() + 3, 0.0);
+}
+
+Histogram Histogram::uniform(double lo, double hi, size_t bins) {
+    assert(lo < hi && bins >= 1);
+    Vector edges(bins + 1);
+    for (size_t i = 0; i < bins; ++i)
+        edges[i] = lo + (hi - lo) * i / bins;
+    edges[bins] = hi;
+
+    Histogram h(Kind::Uniform, std::move(edges));
+    h.lo_ = lo;
+    h.hi_ = hi;
+    h.scale_ = bins / (hi - lo);
+    return h;
+}
+
+Histogram Histogram::log_scale(double lo, double hi, size_t bins) {
+    assert(0.0 < lo && lo < hi && bins >= 1);
+    const double log_lo = std::log(lo), log_hi = std::log(hi);
+    Vector edges(bins + 1);
+    for (size_t i = 0; i < bins; ++i)
+        edges[i] = std::exp(log_lo + (log_hi - log_lo) * i / bins);
+    edges[0] = lo;
+    edges[bins] = hi;
+
+    Histogram h(Kind::Log, std::move(edges));
+    h.lo_ = log_lo;
+    h.hi_ = log_hi;
+    h.scale_ = bins / (log_hi - log_lo);
+    return h;
+}
+
+Histogram Histogram::with_edges(Vector edges) {
+    assert(edges.size() >= 2 && std::is_sorted(edges.begin(), edges.end()));
+    return Histogram(Kind::Edges, std::move(edges));
+}
+
+Histogram Histogram::quantile_bins(ConstVectorSpan sample, size_t bins) {
+    assert(!sample.empty() && bins >= 1);
+    Vector ps(bins + 1);
+    for (size_t i = 0; i <= bins; ++i)
+        ps[i] = static_cast<double>(i) / bins;
+    Vector edges = quantiles(sample, ps);
+
+    // ties in the sample give repeated edges: merge those bins
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    if (edges.size() == 1)
+        edges.push_back(std::nextafter(edges[0], std::numeric_limits<double>::infinity()));
+    return with_edges(std::move(edges));
+}
+
+void Histogram::slots(const double* x, size_t n, uint32_t* out) const {
+    const uint32_t b = static_cast<uint32_t>(bins());
+    switch (kind_) {
+    case Kind::Uniform:
+        simd::kernels().histogram_slots(x, n, lo_, hi_, scale_, b, out);
+        snap_to_edges(x, n, out);
+        return;
+
+    case Kind::Log: {
+        // log first (non-positive values fall below any bin), then the
+        // equal-width kernel on log x
+        double logs[kBlock];
+        for (size_t lo = 0; lo < n; lo += kBlock) {
+            const size_t m = std::min(kBlock, n - lo);
+            for (size_t i = 0; i < m; ++i) {
+                const double v = x[lo + i];
+                logs[i] = v > 0.0 ? std::log(v)
+                        : v != v  ? v
+                                  : -std::numeric_limits<double>::infinity();
+            }
+            simd::kernels().histogram_slots(logs, m, lo_, hi_, scale_, b, out + lo);
+            snap_to_edges(x + lo, m, out + lo);
+        }
+        return;
+    }
+
+    case Kind::Edges: {
+        // branch-free binary search: the number of inner edges <= x is the
+        // bin, found with conditional moves rather than jumps
+        const double* inner = edges_.data() + 1;
+        const size_t m = edges_.size() - 2;
+        size_t top_step = 1;
+        while (top_step * 2 <= m) top_step *= 2;
+        const double first = edges_.front(), last = edges_.back();
+
+        for (size_t i = 0; i < n; ++i) {
+            const double v = x[i];
+            size_t pos = 0;
+            for (size_t step = m == 0 ? 0 : top_step; step > 0; step /= 2)
+                pos += (pos + step <= m && inner[pos + step - 1] <= v) ? step : 0;
+            uint32_t slot = static_cast<uint32_t>(pos) + 1;
+            slot = v < first ? 0 : slot;
+            slot = v > last ? b + 1 : slot;
+            slot = v != v ? b + 2 : slot;
+            out[i] = slot;
+        }
+        return;
+    }
+    }
+}
+
+// floor((x - lo) * scale) and the rounded edges lo + (hi - lo) * i / bins
+// (or their exp) can disagree by a bin right at a boundary; edges_ is what
+// bins are defined by, so step the slot to match it, as numpy does
+void Histogram::snap_to_edges(const double* x, size_t n, uint32_t* out) const {
+    const uint32_t b = static_cast<uint32_t>(bins());
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t slot = out[i];
+        if (slot == 0 || slot > b) continue;   // out of range or NaN: exact already
+        const double v = x[i];
+        while (slot < b && v >= edges_[slot]) ++slot;
+        while (slot > 0 && v < edges_[slot - 1]) --slot;
+        if (slot == b && v > edges_[b]) ++slot;
+        out[i] = slot;
+    }
+}
+
+void Histogram::accumulate(ConstVectorSpan xs, const double* weights, Vector& counts) const {
+    uint32_t index[kBlock];
+    for (size_t lo = 0; lo < xs.size(); lo += kBlock) {
+        const size_t m = std::min(kBlock, xs.size() - lo);
+        slots(xs.data() + lo, m, index);
+        if (weights != nullptr) {
+            for (size_t i = 0; i < m; ++i)
+                counts[index[i]] += weights[lo + i];
+        } else {
+            for (size_t i = 0; i < m; ++i)
+                counts[index[i]] += 1.0;
+        }
+    }
+}
+
+void Histogram::add(double x, double weight) {
+    uint32_t slot;
+    slots(&x, 1, &slot);
+    slots_[slot] += weight;
+}
+
+void Histogram::add(ConstVectorSpan xs) {
+    accumulate(xs, nullptr, slots_);
+}
+
+void Histogram::add(ConstVectorSpan xs, ConstVectorSpan weights) {
+    assert(xs.size() == weights.size());
+    accumulate(xs, weights.data(), slots_);
+}
+
+void Histogram::add_parallel(ConstVectorSpan xs, const double* weights) {
+    const size_t chunks = chunk_count(xs.size(), kMinParallelChunk);
+    std::vector<Vector> partial(chunks, Vector(slots_.size(), 0.0));
+    parallel_for_chunks(chunks, [&](size_t c) {
+        const auto range = chunk_range(xs.size(), chunks, c);
+        accumulate(xs.subspan(range.first, range.second - range.first),
+                   weights != nullptr ? weights + range.first : nullptr, partial[c]);
+    });
+    for (const Vector& counts : partial)
+        for (size_t s = 0; s < slots_.size(); ++s)
+            slots_[s] += counts[s];
+}
+
+void Histogram::add(execution::parallel_policy, ConstVectorSpan xs) {
+    add_parallel(xs, nullptr);
+}
+
+void Histogram::add(execution::parallel_policy, ConstVectorSpan xs, ConstVectorSpan weights) {
+    assert(xs.size() == weights.size());
+    add_parallel(xs, weights.data());
+}
+
+void Histogram::merge(const Histogram& other) {
+    assert(edges_ == other.edges_);
+    for (size_t s = 0; s < slots_.size(); ++s)
+        slots_[s] += other.slots_[s];
+}
+
+Vector Histogram::counts() const {
+    return Vector(slots_.begin() + 1, slots_.begin() + 1 + bins());
+}
+
+double Histogram::total() const {
+    double sum = 0.0;
+    for (size_t i = 0; i < bins(); ++i)
+        sum += count(i);
+    return sum;
+}
+
+size_t Histogram::bin_of(double x) const {
+    uint32_t slot;
+    slots(&x, 1, &slot);
+    return slot >= 1 && slot <= bins() ? slot - 1 : bins();
+}
+
+Vector Histogram::centers() const {
+    Vector result(bins());
+    for (size_t i = 0; i < bins(); ++i)
+        result[i] = kind_ == Kind::Log ? std::sqrt(edges_[i] * edges_[i + 1])
+                                       : (edges_[i] + edges_[i + 1]) / 2.0;
+    return result;
+}
+
+Vector Histogram::density() const {
+    const double n = total();
+    Vector result(bins(), 0.0);
+    if (n == 0.0) return result;
+    for (size_t i = 0; i < bins(); ++i)
+        result[i] = count(i) / (n * (edges_[i + 1] - edges_[i]));
+    return result;
+}
+
+} // namespace ds
@@ -0,0 +1,275 @@
+#include "ds/least_squares.hpp"
+#include "ds/parallel.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace ds {
+namespace {
+
+constexpr size_t kBlock = 64;        // panel width for both factorizations
+constexpr size_t kMinCols = 64;      // right-hand-side columns per thread in the triangular solves
+
+// Unblocked Cholesky of the diagonal block A[k0:k0+kb, k0:k0+kb], whose
+// earlier panels have already been subtracted by the trailing updates
+bool factor_diagonal_block(MatrixView A, size_t k0, size_t kb) {
+    for (size_t j = k0; j < k0 + kb; ++j) {
+        double d = A(j, j);
+        for (size_t p = k0; p < j; ++p)
+            d -= A(j, p) * A(j, p);
+        if (!(d > 0.0)) return false;   // also catches NaN
+        const double ljj = std::sqrt(d);
+        A(j, j) = ljj;
+
+        for (size_t i = j + 1; i < k0 + kb; ++i) {
+            double s = A(i, j);
+            for (size_t p = k0; p < j; ++p)
+                s -= A(i, p) * A(j, p);
+            A(i, j) = s / ljj;
+        }
+    }
+    return true;
+}
+
+// Unblocked Householder QR of one panel held transposed (row j of P is
+// column j of the panel), so every reflector is built and applied with
+// contiguous dot/axpy sweeps. The reflectors overwrite P as in
+// householder_qr().
+void factor_panel(MatrixView P, double* tau) {
+    const size_t len = P.cols();
+    for (size_t j = 0; j < P.rows(); ++j) {
+        VectorSpan x = P.row(j).subspan(j, len - j);
+        VectorSpan v = x.subspan(1, x.size() - 1);   // implicit leading 1
+        const double alpha = x[0];
+        const double sigma = sum_of_squares(ConstVectorSpan(v));
+
+        if (sigma == 0.0) {
+            tau[j] = 0.0;   // already upper-triangular in this column
+            continue;
+        }
+        const double norm = std::sqrt(alpha * alpha + sigma);
+        const double beta = alpha <= 0.0 ? norm : -norm;
+        tau[j] = (beta - alpha) / beta;
+        scal(1.0 / (alpha - beta), v);
+        x[0] = beta;
+
+        for (size_t c = j + 1; c < P.rows(); ++c) {
+            VectorSpan y = P.row(c).subspan(j, len - j);
+            VectorSpan y_tail = y.subspan(1, y.size() - 1);
+            const double w = tau[j] * (y[0] + dot(ConstVectorSpan(v), ConstVectorSpan(y_tail)));
+            y[0] -= w;
+            axpy(-w, v, y_tail);
+        }
+    }
+}
+
+// Apply the panel of reflectors k0 .. k0 + kb - 1 to all of C (the rows
+// k0.. of the target) at once, as Q^T C = C - V T^T (V^T C) with V the
+// unit lower-trapezoidal reflector block and T the kb x kb upper
+// triangular factor of the compact WY form. Both large products are GEMMs,
+// so this is where the factorization spends its time and its threads.
+void apply_block_reflector(ConstMatrixView QR, ConstVectorSpan tau, size_t k0, size_t kb,
+                           MatrixView C) {
+    if (C.cols() == 0) return;
+    const size_t rows = QR.rows() - k0;
+    assert(C.rows() == rows);
+
+    DenseMatrix V(rows, kb);
+    for (size_t i = 0; i < rows; ++i)
+        for (size_t j = 0; j < kb && j <= i; ++j)
+            V(i, j) = (i == j) ? 1.0 : QR(k0 + i, k0 + j);
+    const DenseMatrix Vt = transpose(V);
+
+    // T(0:i, i) = -tau_i T(0:i, 0:i) V(:, 0:i)^T v_i, with S = V^T V
+    const DenseMatrix S = matrix_multiply(Vt, V);
+    DenseMatrix T(kb, kb);
+    for (size_t i = 0; i < kb; ++i) {
+        const double t = tau[k0 + i];
+        T(i, i) = t;
+        for (size_t r = 0; r < i; ++r) {
+            double s = 0.0;
+            for (size_t p = r; p < i; ++p)
+                s += T(r, p) * S(p, i);
+            T(r, i) = -t * s;
+        }
+    }
+
+    DenseMatrix W(kb, C.cols());
+    gemm(1.0, Vt, C, 0.0, W);                    // W = V^T C
+
+    // W = T^T W; row i only needs rows <= i, so go bottom-up in place
+    for (size_t i = kb; i-- > 0;) {
+        VectorSpan wi = W.row(i);
+        scal(T(i, i), wi);
+        for (size_t p = 0; p < i; ++p)
+            axpy(T(p, i), W.row(p), wi);
+    }
+
+    gemm(-1.0, V, W, 1.0, C);                    // C -= V W
+}
+
+// Solve R X = C in place for the upper-triangular n x n R on top of QR;
+// C holds the first n rows of Q^T B
+void back_substitute_upper(ConstMatrixView R, MatrixView C) {
+    const size_t n = C.rows();
+    parallel_for(0, C.cols(), kMinCols, [&](size_t lo, size_t hi) {
+        const size_t width = hi - lo;
+        for (size_t i = n; i-- > 0;) {
+            VectorSpan xi(&C(i, lo), width);
+            for (size_t p = i + 1; p < n; ++p)
+                axpy(-R(i, p), ConstVectorSpan(&C(p, lo), width), xi);
+            scal(1.0 / R(i, i), xi);
+        }
+    });
+}
+
+} // namespace
+
+bool cholesky(MatrixView A) {
+    assert(A.rows() == A.cols());
+    const size_t n = A.rows();
+
+    for (size_t k0 = 0; k0 < n; k0 += kBlock) {
+        const size_t kb = std::min(kBlock, n - k0);
+        if (!factor_diagonal_block(A, k0, kb)) return false;
+
+        const size_t r0 = k0 + kb;
+        if (r0 == n) break;
+
+        // Panel: A21 = A21 L11^{-T}, one independent row solve per row
+        parallel_for(r0, n, 16, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                for (size_t j = k0; j < r0; ++j) {
+                    double s = A(i, j);
+                    for (size_t p = k0; p < j; ++p)
+                        s -= A(i, p) * A(j, p);
+                    A(i, j) = s / A(j, j);
+                }
+            }
+        });
+
+        // Trailing update A22 -= A21 A21^T as one multithreaded GEMM (the
+        // upper half is computed too, which keeps it on the fast path)
+        ConstMatrixView A21 = A.block(r0, k0, n - r0, kb);
+        DenseMatrix A21t(kb, n - r0);
+        transpose(A21, A21t);
+        gemm(-1.0, A21, A21t, 1.0, A.block(r0, r0, n - r0, n - r0));
+    }
+
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = i + 1; j < n; ++j)
+            A(i, j) = 0.0;
+    return true;
+}
+
+void cholesky_solve(ConstMatrixView L, MatrixView B) {
+    assert(L.rows() == L.cols() && L.rows() == B.rows());
+    const size_t n = L.rows();
+
+    // Right-hand sides are independent: each thread sweeps its own columns
+    parallel_for(0, B.cols(), kMinCols, [&](size_t lo, size_t hi) {
+        const size_t width = hi - lo;
+
+        // L Y = B
+        for (size_t i = 0; i < n; ++i) {
+            VectorSpan yi(&B(i, lo), width);
+            for (size_t p = 0; p < i; ++p)
+                axpy(-L(i, p), ConstVectorSpan(&B(p, lo), width), yi);
+            scal(1.0 / L(i, i), yi);
+        }
+
+        // L^T X = Y
+        for (size_t i = n; i-- > 0;) {
+            VectorSpan xi(&B(i, lo), width);
+            for (size_t p = i + 1; p < n; ++p)
+                axpy(-L(p, i), ConstVectorSpan(&B(p, lo), width), xi);
+            scal(1.0 / L(i, i), xi);
+        }
+    });
+}
+
+void householder_qr(MatrixView A, VectorSpan tau) {
+    const size_t m = A.rows();
+    const size_t n = A.cols();
+    assert(m >= n && tau.size() == n);
+
+    for (size_t k0 = 0; k0 < n; k0 += kBlock) {
+        const size_t kb = std::min(kBlock, n - k0);
+
+        // Panel: factored transposed (contiguous columns), then written back
+        MatrixView panel = A.block(k0, k0, m - k0, kb);
+        DenseMatrix P(kb, m - k0);
+        transpose(panel, P);
+        factor_panel(P, tau.data() + k0);
+        transpose(P, panel);
+
+        // Trailing columns: the whole panel of reflectors at once
+        if (k0 + kb < n)
+            apply_block_reflector(A, tau, k0, kb, A.block(k0, k0 + kb, m - k0, n - k0 - kb));
+    }
+}
+
+void apply_qt(ConstMatrixView QR, ConstVectorSpan tau, MatrixView B) {
+    assert(B.rows() == QR.rows() && tau.size() == QR.cols());
+    const size_t n = QR.cols();
+    for (size_t k0 = 0; k0 < n; k0 += kBlock)
+        apply_block_reflector(QR, tau, k0, std::min(kBlock, n - k0),
+                              B.block(k0, 0, B.rows() - k0, B.cols()));
+}
+
+DenseMatrix least_squares_cholesky(ConstMatrixView A, ConstMatrixView B) {
+    assert(A.rows() == B.rows() && A.rows() >= A.cols());
+    const size_t n = A.cols();
+
+    DenseMatrix At(n, A.rows());
+    transpose(A, At);
+
+    DenseMatrix G(n, n);
+    gemm(1.0, At, A, 0.0, G);          // A^T A
+    DenseMatrix X(n, B.cols());
+    gemm(1.0, At, B, 0.0, X);          // A^T B
+
+    if (!cholesky(G))
+        return least_squares_qr(A, B);
+    cholesky_solve(G, X);
+    return X;
+}
+
+DenseMatrix least_squares_qr(ConstMatrixView A, ConstMatrixView B) {
+    assert(A.rows() == B.rows() && A.rows() >= A.cols());
+    const size_t n = A.cols();
+
+    DenseMatrix QR(A.rows(), n);
+    for (size_t i = 0; i < A.rows(); ++i)
+        std::copy(A.row(i).begin(), A.row(i).end(), QR.row(i).begin());
+    DenseMatrix C(B.rows(), B.cols());
+    for (size_t i = 0; i < B.rows(); ++i)
+        std::copy(B.row(i).begin(), B.row(i).end(), C.row(i).begin());
+
+    Vector tau(n);
+    householder_qr(QR, tau);
+    apply_qt(QR, tau, C);
+
+    MatrixView top = C.block(0, 0, n, C.cols());
+    back_substitute_upper(QR, top);
+
+    DenseMatrix X(n, C.cols());
+    for (size_t i = 0; i < n; ++i)
+        std::copy(top.row(i).begin(), top.row(i).end(), X.row(i).begin());
+    return X;
+}
+
+Vector least_squares(ConstMatrixView A, const Vector& y) {
+    assert(A.rows() == y.size());
+    DenseMatrix X = least_squares_qr(A, ConstMatrixView(y.data(), y.size(), 1, 1));
+    return Vector(X.data(), X.data() + X.size());
+}
+
+Vector least_squares_fit(const Vector& x, const Vector& y) {
+    assert(x.size() == y.size() && x.size() >= 2);
+    DenseMatrix A = make_dense_matrix(static_cast<int>(x.size()), 2,
+        [&](int i, int j) { return j == 0 ? x[i] : 1.0; });
+    return least_squares(A, y);   // [slope, intercept]
+}
+
+} // namespace ds
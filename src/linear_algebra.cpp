@@ -1,35 +1,73 @@
 #include "ds/linear_algebra.hpp"
 #include <cassert>
 #include <cmath>
+#include <algorithm>
+#include "ds/parallel.hpp"
+#include "simd_kernels.hpp"
 
 // ---------------- Vector ----------------
+// The hot loops run on the SIMD kernels picked at startup (see ds/simd.hpp).
 namespace ds {
 Vector add(const Vector& v, const Vector& w) {
     assert(v.size() == w.size());
     Vector result(v.size());
-
-    for (size_t i = 0; i < v.size(); ++i)
-        result[i] = v[i] + w[i];
-
+    simd::kernels().add(v.data(), w.data(), result.data(), v.size());
     return result;
 }
 
 Vector subtract(const Vector& v, const Vector& w) {
     assert(v.size() == w.size());
     Vector result(v.size());
-
-    for (size_t i = 0; i < v.size(); ++i)
-        result[i] = v[i] - w[i];
-
+    simd::kernels().subtract(v.data(), w.data(), result.data(), v.size());
     return result;
 }
 
 Vector scalar_multiply(double c, const Vector& v) {
     Vector result(v.size());
+    simd::kernels().scale(c, v.data(), result.data(), v.size());
+    return result;
+}
 
-    for (size_t i = 0; i < v.size(); ++i)
-        result[i] = c * v[i];
-
+// Kahan-compensated sum of `count` vectors of length `dim`, where row_at(r)
+// returns a pointer to the r-th. The rows are split into chunk_count()
+// contiguous ranges; each range keeps its own running sum and compensation
+// and the per-range results are combined in range order, so the result
+// depends only on the input and num_threads(). Must not be built with
+// -ffast-math, which would optimize the compensation away.
+template<typename RowAt>
+static Vector compensated_sum(size_t count, size_t dim, RowAt row_at) {
+    const size_t min_rows = std::max<size_t>(1, 16384 / std::max<size_t>(1, dim));
+    const size_t chunks = chunk_count(count, min_rows);
+
+    DenseMatrix sums(chunks, dim);
+    DenseMatrix comps(chunks, dim);
+
+    auto kahan_add = [dim](double* sum, double* comp, const double* x) {
+        for (size_t i = 0; i < dim; ++i) {
+            const double y = x[i] - comp[i];
+            const double t = sum[i] + y;
+            // an infinite t leaves nothing to compensate (and inf - inf is NaN)
+            comp[i] = std::isfinite(t) ? (t - sum[i]) - y : 0.0;
+            sum[i] = t;
+        }
+    };
+
+    parallel_for_chunks(chunks, [&](size_t c) {
+        auto [lo, hi] = chunk_range(count, chunks, c);
+        double* sum = sums.row(c).data();
+        double* comp = comps.row(c).data();
+        for (size_t r = lo; r < hi; ++r)
+            kahan_add(sum, comp, row_at(r));
+    });
+
+    // Fold each chunk's compensation back in, then combine chunks in order
+    Vector result(dim, 0.0);
+    Vector comp(dim, 0.0);
+    Vector partial(dim);
+    for (size_t c = 0; c < chunks; ++c) {
+        subtract_into(partial, sums.row(c), comps.row(c));
+        kahan_add(result.data(), comp.data(), partial.data());
+    }
     return result;
 }
 
@@ -37,33 +75,47 @@ Vector vector_sum(const std::vector<Vector>& vectors) {
     assert(!vectors.empty());
 
     size_t n = vectors[0].size();
-    Vector result(n, 0.0);
-
-    for (const auto& v : vectors) {
-        assert(v.size() == n);
-        for (size_t i = 0; i < n; ++i)
-            result[i] += v[i];
-    }
+    return compensated_sum(vectors.size(), n, [&](size_t r) {
+        assert(vectors[r].size() == n);
+        return vectors[r].data();
+    });
+}
 
+Vector vector_mean(const std::vector<Vector>& vectors) {
+    Vector result = vector_sum(vectors);
+    scal(1.0 / vectors.size(), result);
     return result;
 }
 
-Vector vector_mean(const std::vector<Vector>& vectors) {
-    return scalar_multiply(1.0 / vectors.size(), vector_sum(vectors));
+Vector vector_sum(ConstMatrixView rows) {
+    assert(rows.rows() > 0);
+    return compensated_sum(rows.rows(), rows.cols(), [&](size_t r) {
+        return rows.row(r).data();
+    });
+}
+
+Vector vector_mean(ConstMatrixView rows) {
+    Vector result = vector_sum(rows);
+    scal(1.0 / rows.rows(), result);
+    return result;
 }
 
 double dot(const Vector& v, const Vector& w) {
     assert(v.size() == w.size());
+    return simd::kernels().dot(v.data(), w.data(), v.size());
+}
 
-    double sum = 0.0;
-    for (size_t i = 0; i < v.size(); ++i)
-        sum += v[i] * w[i];
-
-    return sum;
+double dot(ConstVectorSpan v, ConstVectorSpan w) {
+    assert(v.size() == w.size());
+    return simd::kernels().dot(v.data(), w.data(), v.size());
 }
 
 double sum_of_squares(const Vector& v) {
-    return dot(v, v);
+    return simd::kernels().sum_of_squares(v.data(), v.size());
+}
+
+double sum_of_squares(ConstVectorSpan v) {
+    return simd::kernels().sum_of_squares(v.data(), v.size());
 }
 
 double magnitude(const Vector& v) {
@@ -71,11 +123,124 @@ double magnitude(const Vector& v) {
 }
 
 double squared_distance(const Vector& v, const Vector& w) {
-    return sum_of_squares(subtract(v, w));
+    assert(v.size() == w.size());
+    return simd::kernels().squared_distance(v.data(), w.data(), v.size());
 }
 
 double distance(const Vector& v, const Vector& w) {
-    return magnitude(subtract(v, w));
+    return std::sqrt(squared_distance(v, w));
+}
+
+// ---------------- In-place ----------------
+
+void axpy(double a, ConstVectorSpan x, VectorSpan y) {
+    assert(x.size() == y.size());
+    simd::kernels().axpy(a, x.data(), y.data(), y.size());
+}
+
+void scal(double a, VectorSpan x) {
+    simd::kernels().scale(a, x.data(), x.data(), x.size());
+}
+
+void add_into(VectorSpan out, ConstVectorSpan v, ConstVectorSpan w) {
+    assert(v.size() == w.size() && out.size() == v.size());
+    simd::kernels().add(v.data(), w.data(), out.data(), out.size());
+}
+
+void subtract_into(VectorSpan out, ConstVectorSpan v, ConstVectorSpan w) {
+    assert(v.size() == w.size() && out.size() == v.size());
+    simd::kernels().subtract(v.data(), w.data(), out.data(), out.size());
+}
+
+void scale_into(VectorSpan out, double c, ConstVectorSpan v) {
+    assert(out.size() == v.size());
+    simd::kernels().scale(c, v.data(), out.data(), out.size());
+}
+
+void accumulate(VectorSpan acc, ConstVectorSpan v) {
+    assert(acc.size() == v.size());
+    simd::kernels().add(acc.data(), v.data(), acc.data(), acc.size());
+}
+
+// ---------------- Single precision ----------------
+
+FloatVector to_float(ConstVectorSpan v) {
+    return FloatVector(v.begin(), v.end());
+}
+
+Vector to_double(ConstFloatSpan v) {
+    return Vector(v.begin(), v.end());
+}
+
+FloatVector add(const FloatVector& v, const FloatVector& w) {
+    assert(v.size() == w.size());
+    FloatVector result(v.size());
+    simd::kernels().f32.add(v.data(), w.data(), result.data(), v.size());
+    return result;
+}
+
+FloatVector subtract(const FloatVector& v, const FloatVector& w) {
+    assert(v.size() == w.size());
+    FloatVector result(v.size());
+    simd::kernels().f32.subtract(v.data(), w.data(), result.data(), v.size());
+    return result;
+}
+
+FloatVector scalar_multiply(float c, const FloatVector& v) {
+    FloatVector result(v.size());
+    simd::kernels().f32.scale(c, v.data(), result.data(), v.size());
+    return result;
+}
+
+double dot(ConstFloatSpan v, ConstFloatSpan w) {
+    assert(v.size() == w.size());
+    return simd::kernels().f32.dot(v.data(), w.data(), v.size());
+}
+
+double sum_of_squares(ConstFloatSpan v) {
+    return simd::kernels().f32.sum_of_squares(v.data(), v.size());
+}
+
+double magnitude(ConstFloatSpan v) {
+    return std::sqrt(sum_of_squares(v));
+}
+
+double squared_distance(ConstFloatSpan v, ConstFloatSpan w) {
+    assert(v.size() == w.size());
+    return simd::kernels().f32.squared_distance(v.data(), w.data(), v.size());
+}
+
+double distance(ConstFloatSpan v, ConstFloatSpan w) {
+    return std::sqrt(squared_distance(v, w));
+}
+
+void axpy(float a, ConstFloatSpan x, FloatSpan y) {
+    assert(x.size() == y.size());
+    simd::kernels().f32.axpy(a, x.data(), y.data(), y.size());
+}
+
+void scal(float a, FloatSpan x) {
+    simd::kernels().f32.scale(a, x.data(), x.data(), x.size());
+}
+
+void add_into(FloatSpan out, ConstFloatSpan v, ConstFloatSpan w) {
+    assert(v.size() == w.size() && out.size() == v.size());
+    simd::kernels().f32.add(v.data(), w.data(), out.data(), out.size());
+}
+
+void subtract_into(FloatSpan out, ConstFloatSpan v, ConstFloatSpan w) {
+    assert(v.size() == w.size() && out.size() == v.size());
+    simd::kernels().f32.subtract(v.data(), w.data(), out.data(), out.size());
+}
+
+void scale_into(FloatSpan out, float c, ConstFloatSpan v) {
+    assert(out.size() == v.size());
+    simd::kernels().f32.scale(c, v.data(), out.data(), out.size());
+}
+
+void accumulate(FloatSpan acc, ConstFloatSpan v) {
+    assert(acc.size() == v.size());
+    simd::kernels().f32.add(acc.data(), v.data(), acc.data(), acc.size());
 }
 
 // ---------------- Matrix ----------------
@@ -99,24 +264,86 @@ Vector get_column(const Matrix& A, int j) {
     return column;
 }
 
-Matrix make_matrix(
-    int num_rows,
-    int num_cols,
-    std::function<double(int, int)> entry_fn) {
+// make_matrix / make_dense_matrix are templates in the header
+
+// The special matrices are built directly instead of calling an entry
+// function for every element.
+Matrix identity_matrix(int n) {
+    Matrix result(n, Vector(n, 0.0));
+    for (int i = 0; i < n; ++i)
+        result[i][i] = 1.0;
+    return result;
+}
+
+Matrix diagonal_matrix(const Vector& diagonal) {
+    const size_t n = diagonal.size();
+    Matrix result(n, Vector(n, 0.0));
+    for (size_t i = 0; i < n; ++i)
+        result[i][i] = diagonal[i];
+    return result;
+}
 
-    Matrix result(num_rows, Vector(num_cols));
+Matrix constant_matrix(int num_rows, int num_cols, double value) {
+    return Matrix(num_rows, Vector(num_cols, value));
+}
 
-    for (int i = 0; i < num_rows; ++i)
-        for (int j = 0; j < num_cols; ++j)
-            result[i][j] = entry_fn(i, j);
+// ---------------- Dense Matrix ----------------
+
+std::pair<int, int> shape(const DenseMatrix& A) {
+    return {static_cast<int>(A.rows()), static_cast<int>(A.cols())};
+}
+
+ConstVectorSpan get_row(const DenseMatrix& A, int i) {
+    return A.row(i);
+}
+
+ConstStridedSpan get_column(const DenseMatrix& A, int j) {
+    return A.column(j);
+}
+
+DenseMatrix dense_identity_matrix(int n) {
+    DenseMatrix result(n, n);
+
+    for (int i = 0; i < n; ++i)
+        result(i, i) = 1.0;
 
     return result;
 }
 
-Matrix identity_matrix(int n) {
-    return make_matrix(n, n,
-        [](int i, int j) {
-            return (i == j) ? 1.0 : 0.0;
-        });
+DenseMatrix dense_diagonal_matrix(ConstVectorSpan diagonal) {
+    const size_t n = diagonal.size();
+    DenseMatrix result(n, n);
+
+    for (size_t i = 0; i < n; ++i)
+        result(i, i) = diagonal[i];
+
+    return result;
+}
+
+DenseMatrix dense_constant_matrix(int num_rows, int num_cols, double value) {
+    return DenseMatrix(num_rows, num_cols, value);
+}
+
+DenseMatrix to_dense(const Matrix& A) {
+    auto [rows, cols] = shape(A);
+    DenseMatrix result(rows, cols);
+
+    for (int i = 0; i < rows; ++i) {
+        assert(static_cast<int>(A[i].size()) == cols);
+        std::copy(A[i].begin(), A[i].end(), result.row(i).begin());
+    }
+
+    return result;
+}
+
+Matrix to_nested(const DenseMatrix& A) {
+    Matrix result(A.rows());
+
+    for (size_t i = 0; i < A.rows(); ++i) {
+        auto row = A.row(i);
+        result[i].assign(row.begin(), row.end());
+    }
+
+    return result;
+}
 }
-}
\ No newline at end of file
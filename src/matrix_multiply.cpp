@@ -0,0 +1,250 @@
+#include "ds/linear_algebra.hpp"
+#include "ds/parallel.hpp"
+#include "simd_kernels.hpp"
+#include <algorithm>
+#include <cassert>
+
+// ---------------- GEMM ----------------
+//
+// Goto/BLIS-style blocking: C is swept in NC-wide column panels; for every
+// KC-deep slice of the inner dimension a KC x NC panel of B is packed once
+// (it stays in L3/L2) and shared by all threads. Threads then take MC-row
+// blocks of A, pack them into a private buffer (sized for L2) and run the
+// SIMD micro-kernel over mr x nr register tiles. Each entry of C is always
+// accumulated in the same k order, so results do not depend on the number
+// of threads.
+
+namespace ds {
+namespace {
+
+constexpr size_t kMC = 96;     // rows of A per block (multiple of every mr)
+constexpr size_t kKC = 256;    // depth of a packed panel
+constexpr size_t kNC = 2048;   // columns of B per panel (multiple of every nr)
+
+// Pack rows [i0, i0 + mc) x columns [p0, p0 + kc) of alpha * A into mr-row
+// slivers, zero-padding the last sliver.
+void pack_a(ConstMatrixView A, size_t i0, size_t mc, size_t p0, size_t kc,
+            double alpha, size_t mr, double* out) {
+    for (size_t ir = 0; ir < mc; ir += mr) {
+        const size_t rows = std::min(mr, mc - ir);
+        for (size_t r = 0; r < mr; ++r) {
+            double* dst = out + r;
+            if (r < rows) {
+                const double* src = A.data() + (i0 + ir + r) * A.stride() + p0;
+                for (size_t p = 0; p < kc; ++p)
+                    dst[p * mr] = alpha * src[p];
+            } else {
+                for (size_t p = 0; p < kc; ++p)
+                    dst[p * mr] = 0.0;
+            }
+        }
+        out += mr * kc;
+    }
+}
+
+// Pack rows [p0, p0 + kc) x columns [j0 + jr_begin, j0 + jr_end) of B into
+// nr-column slivers, zero-padding the last sliver.
+void pack_b(ConstMatrixView B, size_t p0, size_t kc, size_t j0, size_t nc,
+            size_t jr_begin, size_t jr_end, size_t nr, double* out) {
+    for (size_t jr = jr_begin; jr < jr_end; jr += nr) {
+        const size_t cols = std::min(nr, nc - jr);
+        double* dst = out + jr * kc;
+        for (size_t p = 0; p < kc; ++p, dst += nr) {
+            const double* src = B.data() + (p0 + p) * B.stride() + j0 + jr;
+            size_t c = 0;
+            for (; c < cols; ++c) dst[c] = src[c];
+            for (; c < nr; ++c) dst[c] = 0.0;
+        }
+    }
+}
+
+void macro_kernel(const simd::KernelTable& k, size_t mc, size_t nc, size_t kc,
+                  const double* a_pack, const double* b_pack, MatrixView C) {
+    const size_t mr = k.gemm_mr;
+    const size_t nr = k.gemm_nr;
+    double edge[16 * 16];
+
+    for (size_t jr = 0; jr < nc; jr += nr) {
+        const size_t cols = std::min(nr, nc - jr);
+        const double* b = b_pack + jr * kc;
+        for (size_t ir = 0; ir < mc; ir += mr) {
+            const size_t rows = std::min(mr, mc - ir);
+            const double* a = a_pack + ir * kc;
+
+            if (rows == mr && cols == nr) {
+                k.gemm_kernel(kc, a, b, &C(ir, jr), C.stride());
+                continue;
+            }
+
+            // Partial tile: compute the full tile into scratch, add the valid part
+            std::fill(edge, edge + mr * nr, 0.0);
+            k.gemm_kernel(kc, a, b, edge, nr);
+            for (size_t r = 0; r < rows; ++r)
+                for (size_t c = 0; c < cols; ++c)
+                    C(ir + r, jr + c) += edge[r * nr + c];
+        }
+    }
+}
+
+void scale_matrix(double beta, MatrixView C) {
+    if (beta == 1.0) return;
+    parallel_for(0, C.rows(), 64, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            auto row = C.row(i);
+            if (beta == 0.0)
+                std::fill(row.begin(), row.end(), 0.0);   // do not propagate NaN/Inf from C
+            else
+                for (double& x : row) x *= beta;
+        }
+    });
+}
+
+} // namespace
+
+void gemm(double alpha, ConstMatrixView A, ConstMatrixView B, double beta, MatrixView C) {
+    assert(A.cols() == B.rows());
+    assert(C.rows() == A.rows() && C.cols() == B.cols());
+
+    const size_t m = A.rows();
+    const size_t n = B.cols();
+    const size_t kdim = A.cols();
+
+    scale_matrix(beta, C);
+    if (m == 0 || n == 0 || kdim == 0 || alpha == 0.0) return;
+
+    const auto& k = simd::kernels();
+    const size_t mr = k.gemm_mr;
+    const size_t nr = k.gemm_nr;
+
+    // Reused across calls; sized for this problem, not the maximum panel.
+    // Workers must use this thread's buffer through the pointer: naming the
+    // thread_local inside the tasks would give each worker its own copy.
+    thread_local AlignedVector<double> b_pack_storage;
+    const size_t nc_max = std::min(kNC, (n + nr - 1) / nr * nr);
+    b_pack_storage.resize(std::max(b_pack_storage.size(), std::min(kKC, kdim) * nc_max));
+    double* const b_pack = b_pack_storage.data();
+
+    for (size_t jc = 0; jc < n; jc += kNC) {
+        const size_t nc = std::min(kNC, n - jc);
+        const size_t nc_slivers = (nc + nr - 1) / nr;
+
+        for (size_t pc = 0; pc < kdim; pc += kKC) {
+            const size_t kc = std::min(kKC, kdim - pc);
+
+            parallel_for(0, nc_slivers, 8, [&](size_t lo, size_t hi) {
+                pack_b(B, pc, kc, jc, nc, lo * nr, std::min(hi * nr, nc), nr, b_pack);
+            });
+
+            const size_t row_blocks = (m + kMC - 1) / kMC;
+            parallel_for(0, row_blocks, 1, [&](size_t lo, size_t hi) {
+                thread_local AlignedVector<double> a_pack;
+                a_pack.resize(std::max(a_pack.size(), kMC * kKC));
+
+                for (size_t blk = lo; blk < hi; ++blk) {
+                    const size_t ic = blk * kMC;
+                    const size_t mc = std::min(kMC, m - ic);
+                    pack_a(A, ic, mc, pc, kc, alpha, mr, a_pack.data());
+                    macro_kernel(k, mc, nc, kc, a_pack.data(), b_pack,
+                                 C.block(ic, jc, mc, nc));
+                }
+            });
+        }
+    }
+}
+
+DenseMatrix matrix_multiply(const DenseMatrix& A, const DenseMatrix& B) {
+    DenseMatrix C(A.rows(), B.cols());
+    gemm(1.0, A, B, 0.0, C);
+    return C;
+}
+
+Matrix matrix_multiply(const Matrix& A, const Matrix& B) {
+    return to_nested(matrix_multiply(to_dense(A), to_dense(B)));
+}
+
+// ---------------- GEMV ----------------
+
+void gemv(double alpha, ConstMatrixView A, ConstVectorSpan x, double beta, VectorSpan y) {
+    assert(A.cols() == x.size());
+    assert(A.rows() == y.size());
+
+    const auto& k = simd::kernels();
+    const size_t min_rows = std::max<size_t>(1, 32768 / std::max<size_t>(1, A.cols()));
+
+    parallel_for(0, A.rows(), min_rows, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            const double ax = alpha * k.dot(A.row(i).data(), x.data(), x.size());
+            y[i] = (beta == 0.0) ? ax : ax + beta * y[i];
+        }
+    });
+}
+
+Vector matvec(const DenseMatrix& A, const Vector& x) {
+    Vector y(A.rows());
+    gemv(1.0, A, x, 0.0, y);
+    return y;
+}
+
+Vector matvec(const Matrix& A, const Vector& x) {
+    Vector y(A.size());
+    const auto& k = simd::kernels();
+    const size_t min_rows = std::max<size_t>(1, 32768 / std::max<size_t>(1, x.size()));
+
+    parallel_for(0, A.size(), min_rows, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            assert(A[i].size() == x.size());
+            y[i] = k.dot(A[i].data(), x.data(), x.size());
+        }
+    });
+    return y;
+}
+
+// ---------------- Transpose ----------------
+
+namespace {
+
+// Cache-oblivious: halve the longer side until the tile fits comfortably
+// in L1, so both the reads and the strided writes stay cache-resident at
+// every level of the hierarchy without tuning for a particular cache size.
+void transpose_rec(ConstMatrixView A, MatrixView out,
+                   size_t r0, size_t r1, size_t c0, size_t c1) {
+    const size_t rows = r1 - r0;
+    const size_t cols = c1 - c0;
+
+    if (rows <= 32 && cols <= 32) {
+        for (size_t i = r0; i < r1; ++i)
+            for (size_t j = c0; j < c1; ++j)
+                out(j, i) = A(i, j);
+        return;
+    }
+
+    if (rows >= cols) {
+        const size_t mid = r0 + rows / 2;
+        transpose_rec(A, out, r0, mid, c0, c1);
+        transpose_rec(A, out, mid, r1, c0, c1);
+    } else {
+        const size_t mid = c0 + cols / 2;
+        transpose_rec(A, out, r0, r1, c0, mid);
+        transpose_rec(A, out, r0, r1, mid, c1);
+    }
+}
+
+} // namespace
+
+void transpose(ConstMatrixView A, MatrixView out) {
+    assert(out.rows() == A.cols() && out.cols() == A.rows());
+    if (A.rows() == 0 || A.cols() == 0) return;
+    transpose_rec(A, out, 0, A.rows(), 0, A.cols());
+}
+
+DenseMatrix transpose(const DenseMatrix& A) {
+    DenseMatrix result(A.cols(), A.rows());
+    transpose(A, result);
+    return result;
+}
+
+Matrix transpose(const Matrix& A) {
+    return to_nested(transpose(to_dense(A)));
+}
+
+} // namespace ds
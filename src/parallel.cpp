@@ -0,0 +1,160 @@
+#include "ds/parallel.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ds {
+namespace {
+
+// True while the current thread executes a pool task; nested parallel
+// calls then run inline instead of waiting on the (busy) pool.
+thread_local bool in_pool_task = false;
+
+size_t hardware_threads() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+// One parallel_for_chunks call. Workers hold a shared_ptr, so a worker that
+// wakes up late only ever sees an exhausted job, never the next one.
+struct Job {
+    const std::function<void(size_t)>* fn;
+    size_t num_tasks;
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> remaining;
+    std::mutex error_mutex;
+    std::exception_ptr error;
+
+    Job(const std::function<void(size_t)>* fn, size_t num_tasks)
+        : fn(fn), num_tasks(num_tasks), remaining(num_tasks) {}
+};
+
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads) {
+        for (size_t i = 1; i < threads; ++i)
+            workers_.emplace_back([this] { worker_loop(); });
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& t : workers_)
+            t.join();
+    }
+
+    void run(size_t num_tasks, const std::function<void(size_t)>& fn) {
+        auto job = std::make_shared<Job>(&fn, num_tasks);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = job;
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        drain(*job);
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait(lock, [&] { return job->remaining.load() == 0; });
+            job_.reset();
+        }
+        if (job->error)
+            std::rethrow_exception(job->error);
+    }
+
+private:
+    void worker_loop() {
+        size_t seen = 0;
+        for (;;) {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) return;
+                seen = generation_;
+                job = job_;
+            }
+            if (job) drain(*job);
+        }
+    }
+
+    void drain(Job& job) {
+        for (;;) {
+            size_t t = job.next.fetch_add(1);
+            if (t >= job.num_tasks) return;
+
+            in_pool_task = true;
+            try {
+                (*job.fn)(t);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(job.error_mutex);
+                if (!job.error) job.error = std::current_exception();
+            }
+            in_pool_task = false;
+
+            if (job.remaining.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                done_.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::shared_ptr<Job> job_;
+    size_t generation_ = 0;
+    bool stop_ = false;
+};
+
+std::atomic<size_t> configured_threads{0};   // 0 = hardware default
+std::mutex pool_mutex;                         // held while the pool runs a job
+std::unique_ptr<ThreadPool> pool;
+
+} // namespace
+
+size_t num_threads() {
+    size_t n = configured_threads.load(std::memory_order_relaxed);
+    return n == 0 ? hardware_threads() : n;
+}
+
+void set_num_threads(size_t n) {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    configured_threads.store(n, std::memory_order_relaxed);
+    pool.reset();   // rebuilt lazily with the new size
+}
+
+void parallel_for_chunks(size_t num_chunks, const std::function<void(size_t)>& fn) {
+    auto run_serial = [&] {
+        for (size_t c = 0; c < num_chunks; ++c)
+            fn(c);
+    };
+
+    if (num_chunks <= 1 || in_pool_task || num_threads() == 1) {
+        run_serial();
+        return;
+    }
+
+    // Another thread is already using the pool: do the work here rather
+    // than queue behind it. Chunking is unchanged, so results are too.
+    std::unique_lock<std::mutex> lock(pool_mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        run_serial();
+        return;
+    }
+
+    if (!pool)
+        pool = std::make_unique<ThreadPool>(num_threads());
+    pool->run(num_chunks, fn);
+}
+
+} // namespace ds
@@ -0,0 +1,325 @@
+#include "ds/rolling.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+namespace ds {
+namespace {
+
+// Re-sum the window exactly after this many removals at least (and never
+// less than once per window length), which keeps the amortized cost O(1)
+constexpr size_t kMinRemovalsPerResum = 64;
+
+template<typename Entry>
+bool expired(const Window& window, const std::deque<Entry>& values, double newest) {
+    if (window.count > 0) return values.size() > window.count;
+    return values.front().t <= newest - window.duration;
+}
+
+} // namespace
+
+Window Window::last(size_t n) {
+    assert(n >= 1);
+    Window w;
+    w.count = n;
+    return w;
+}
+
+Window Window::within(double duration) {
+    assert(duration > 0.0);
+    Window w;
+    w.duration = duration;
+    return w;
+}
+
+// ---------------- RollingStats ----------------
+
+RollingStats::RollingStats(Window window) : window_(window) {}
+
+void RollingStats::push(double x) {
+    assert(window_.count > 0);
+    push(static_cast<double>(pushed_), x);
+}
+
+void RollingStats::push(double t, double x) {
+    assert(values_.empty() || t >= values_.back().t);
+    ++pushed_;
+    insert(t, x);
+    evict(t);
+}
+
+void RollingStats::insert(double t, double x) {
+    values_.push_back({t, x});
+    const double delta = x - mean_;
+    mean_ += delta / values_.size();
+    m2_ += delta * (x - mean_);
+}
+
+void RollingStats::evict(double newest) {
+    bool removed_any = false, resum = false;
+    while (!values_.empty() && expired(window_, values_, newest)) {
+        const double x = values_.front().x;
+        values_.pop_front();
+        const size_t n = values_.size();
+        if (n == 0) {
+            mean_ = m2_ = 0.0;
+        } else if (!std::isfinite(x)) {
+            resum = true;   // a NaN or infinity cannot be subtracted back out
+        } else {
+            // inverse of Welford's update
+            const double mean = mean_ - (x - mean_) / n;
+            m2_ -= (x - mean) * (x - mean_);
+            mean_ = mean;
+        }
+        ++removed_;
+        removed_any = true;
+    }
+    if (resum || (removed_any && removed_ >= std::max(kMinRemovalsPerResum, values_.size())))
+        recompute();
+}
+
+void RollingStats::recompute() {
+    removed_ = 0;
+    if (values_.empty()) return;
+    double sum = 0.0;
+    for (const Entry& e : values_) sum += e.x;
+    mean_ = sum / values_.size();
+    m2_ = 0.0;
+    for (const Entry& e : values_) m2_ += (e.x - mean_) * (e.x - mean_);
+}
+
+double RollingStats::variance() const {
+    assert(values_.size() >= 2);
+    return std::max(0.0, m2_) / (values_.size() - 1);
+}
+
+double RollingStats::standard_deviation() const {
+    return std::sqrt(variance());
+}
+
+// ---------------- RollingCovariance ----------------
+
+RollingCovariance::RollingCovariance(Window window) : window_(window) {}
+
+void RollingCovariance::push(double x, double y) {
+    assert(window_.count > 0);
+    push(static_cast<double>(pushed_), x, y);
+}
+
+void RollingCovariance::push(double t, double x, double y) {
+    assert(values_.empty() || t >= values_.back().t);
+    ++pushed_;
+    insert(t, x, y);
+    evict(t);
+}
+
+void RollingCovariance::insert(double t, double x, double y) {
+    values_.push_back({t, x, y});
+    const double n = static_cast<double>(values_.size());
+    const double dx = x - mean_x_;
+    mean_x_ += dx / n;
+    const double dy = y - mean_y_;
+    mean_y_ += dy / n;
+    m2_x_ += dx * (x - mean_x_);
+    m2_y_ += dy * (y - mean_y_);
+    c_xy_ += dx * (y - mean_y_);
+}
+
+void RollingCovariance::evict(double newest) {
+    bool removed_any = false, resum = false;
+    while (!values_.empty() && expired(window_, values_, newest)) {
+        const Entry e = values_.front();
+        values_.pop_front();
+        const size_t n = values_.size();
+        if (n == 0) {
+            mean_x_ = mean_y_ = m2_x_ = m2_y_ = c_xy_ = 0.0;
+        } else if (!std::isfinite(e.x) || !std::isfinite(e.y)) {
+            resum = true;
+        } else {
+            const double mx = mean_x_ - (e.x - mean_x_) / n;
+            const double my = mean_y_ - (e.y - mean_y_) / n;
+            m2_x_ -= (e.x - mx) * (e.x - mean_x_);
+            m2_y_ -= (e.y - my) * (e.y - mean_y_);
+            c_xy_ -= (e.x - mx) * (e.y - mean_y_);
+            mean_x_ = mx;
+            mean_y_ = my;
+        }
+        ++removed_;
+        removed_any = true;
+    }
+    if (resum || (removed_any && removed_ >= std::max(kMinRemovalsPerResum, values_.size())))
+        recompute();
+}
+
+void RollingCovariance::recompute() {
+    removed_ = 0;
+    if (values_.empty()) return;
+    double sx = 0.0, sy = 0.0;
+    for (const Entry& e : values_) {
+        sx += e.x;
+        sy += e.y;
+    }
+    mean_x_ = sx / values_.size();
+    mean_y_ = sy / values_.size();
+    m2_x_ = m2_y_ = c_xy_ = 0.0;
+    for (const Entry& e : values_) {
+        const double dx = e.x - mean_x_, dy = e.y - mean_y_;
+        m2_x_ += dx * dx;
+        m2_y_ += dy * dy;
+        c_xy_ += dx * dy;
+    }
+}
+
+double RollingCovariance::variance_x() const {
+    assert(values_.size() >= 2);
+    return std::max(0.0, m2_x_) / (values_.size() - 1);
+}
+
+double RollingCovariance::variance_y() const {
+    assert(values_.size() >= 2);
+    return std::max(0.0, m2_y_) / (values_.size() - 1);
+}
+
+double RollingCovariance::covariance() const {
+    assert(values_.size() >= 2);
+    return c_xy_ / (values_.size() - 1);
+}
+
+double RollingCovariance::correlation() const {
+    if (m2_x_ > 0 && m2_y_ > 0)
+        return c_xy_ / std::sqrt(m2_x_) / std::sqrt(m2_y_);
+    return 0;
+}
+
+// ---------------- RollingQuantile ----------------
+
+RollingQuantile::RollingQuantile(Window window, double p) : window_(window), p_(p) {
+    assert(p >= 0.0 && p <= 1.0);
+}
+
+void RollingQuantile::push(double x) {
+    assert(window_.count > 0);
+    push(static_cast<double>(pushed_), x);
+}
+
+void RollingQuantile::push(double t, double x) {
+    assert(values_.empty() || t >= values_.back().t);
+    ++pushed_;
+    values_.push_back({t, x});
+    // NaNs have no place in an ordered set; they are only counted
+    if (std::isnan(x))
+        ++nans_;
+    else
+        insert(x);
+    evict(t);
+    rebalance();
+}
+
+// Invariant: every element of lower_ <= every element of upper_
+void RollingQuantile::insert(double x) {
+    if (!lower_.empty() && x <= *lower_.rbegin())
+        lower_.insert(x);
+    else
+        upper_.insert(x);
+}
+
+void RollingQuantile::erase(double x) {
+    // x <= max(lower) means a copy of x is in lower_ (anything in upper_
+    // is >= max(lower), so a smaller x cannot be there)
+    if (!lower_.empty() && x <= *lower_.rbegin())
+        lower_.erase(lower_.find(x));
+    else
+        upper_.erase(upper_.find(x));
+}
+
+void RollingQuantile::rebalance() {
+    const size_t n = values_.size() - nans_;
+    const size_t k = n == 0 ? 0 : std::min(n - 1, static_cast<size_t>(p_ * n));
+    while (lower_.size() > k) {
+        auto last = std::prev(lower_.end());
+        upper_.insert(*last);
+        lower_.erase(last);
+    }
+    while (lower_.size() < k) {
+        lower_.insert(*upper_.begin());
+        upper_.erase(upper_.begin());
+    }
+}
+
+void RollingQuantile::evict(double newest) {
+    while (!values_.empty() && expired(window_, values_, newest)) {
+        const double x = values_.front().x;
+        if (std::isnan(x))
+            --nans_;
+        else
+            erase(x);
+        values_.pop_front();
+    }
+}
+
+double RollingQuantile::quantile() const {
+    assert(!values_.empty());
+    if (nans_ > 0) return std::numeric_limits<double>::quiet_NaN();
+    return *upper_.begin();
+}
+
+double RollingQuantile::median() const {
+    assert(p_ == 0.5 && !values_.empty());
+    if (nans_ > 0) return std::numeric_limits<double>::quiet_NaN();
+    if (values_.size() % 2 == 1) return *upper_.begin();
+    return (*lower_.rbegin() + *upper_.begin()) / 2.0;
+}
+
+// ---------------- whole-series helpers ----------------
+
+Vector rolling_mean(ConstVectorSpan xs, size_t window) {
+    assert(window >= 1 && window <= xs.size());
+    RollingStats stats(Window::last(window));
+    Vector result;
+    result.reserve(xs.size() - window + 1);
+    for (size_t i = 0; i < xs.size(); ++i) {
+        stats.push(xs[i]);
+        if (i + 1 >= window) result.push_back(stats.mean());
+    }
+    return result;
+}
+
+Vector rolling_variance(ConstVectorSpan xs, size_t window) {
+    assert(window >= 2 && window <= xs.size());
+    RollingStats stats(Window::last(window));
+    Vector result;
+    result.reserve(xs.size() - window + 1);
+    for (size_t i = 0; i < xs.size(); ++i) {
+        stats.push(xs[i]);
+        if (i + 1 >= window) result.push_back(stats.variance());
+    }
+    return result;
+}
+
+Vector rolling_median(ConstVectorSpan xs, size_t window) {
+    assert(window >= 1 && window <= xs.size());
+    RollingQuantile q(Window::last(window), 0.5);
+    Vector result;
+    result.reserve(xs.size() - window + 1);
+    for (size_t i = 0; i < xs.size(); ++i) {
+        q.push(xs[i]);
+        if (i + 1 >= window) result.push_back(q.median());
+    }
+    return result;
+}
+
+Vector rolling_quantile(ConstVectorSpan xs, size_t window, double p) {
+    assert(window >= 1 && window <= xs.size());
+    RollingQuantile q(Window::last(window), p);
+    Vector result;
+    result.reserve(xs.size() - window + 1);
+    for (size_t i = 0; i < xs.size(); ++i) {
+        q.push(xs[i]);
+        if (i + 1 >= window) result.push_back(q.quantile());
+    }
+    return result;
+}
+
+} // namespace ds
@@ -0,0 +1,251 @@
+#include "simd_kernels.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+
+namespace ds {
+namespace simd {
+
+// ---------------- Scalar kernels ----------------
+// Templated on the element type and instantiated for double and float.
+// Reductions always accumulate in double. Four independent accumulators so
+// the loop carries no single serial dependency chain; combined pairwise as
+// (s0 + s1) + (s2 + s3).
+
+template<typename T>
+static double scalar_dot(const T* a, const T* b, size_t n) {
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += double(a[i]) * b[i];
+        s1 += double(a[i + 1]) * b[i + 1];
+        s2 += double(a[i + 2]) * b[i + 2];
+        s3 += double(a[i + 3]) * b[i + 3];
+    }
+    for (; i < n; ++i)
+        s0 += double(a[i]) * b[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+template<typename T>
+static double scalar_sum_of_squares(const T* a, size_t n) {
+    return scalar_dot(a, a, n);
+}
+
+template<typename T>
+static double scalar_squared_distance(const T* a, const T* b, size_t n) {
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const double d0 = double(a[i]) - b[i];
+        const double d1 = double(a[i + 1]) - b[i + 1];
+        const double d2 = double(a[i + 2]) - b[i + 2];
+        const double d3 = double(a[i + 3]) - b[i + 3];
+        s0 += d0 * d0;
+        s1 += d1 * d1;
+        s2 += d2 * d2;
+        s3 += d3 * d3;
+    }
+    for (; i < n; ++i) {
+        const double d = double(a[i]) - b[i];
+        s0 += d * d;
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+template<typename T>
+static double scalar_sum(const T* a, size_t n) {
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += a[i];
+        s1 += a[i + 1];
+        s2 += a[i + 2];
+        s3 += a[i + 3];
+    }
+    for (; i < n; ++i)
+        s0 += a[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+template<typename T>
+static double scalar_centered_dot(const T* a, const T* b, double ca, double cb, size_t n) {
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += (a[i] - ca) * (b[i] - cb);
+        s1 += (a[i + 1] - ca) * (b[i + 1] - cb);
+        s2 += (a[i + 2] - ca) * (b[i + 2] - cb);
+        s3 += (a[i + 3] - ca) * (b[i + 3] - cb);
+    }
+    for (; i < n; ++i)
+        s0 += (a[i] - ca) * (b[i] - cb);
+    return (s0 + s1) + (s2 + s3);
+}
+
+template<typename T>
+static void scalar_add(const T* a, const T* b, T* out, size_t n) {
+    for (size_t i = 0; i < n; ++i)
+        out[i] = a[i] + b[i];
+}
+
+template<typename T>
+static void scalar_subtract(const T* a, const T* b, T* out, size_t n) {
+    for (size_t i = 0; i < n; ++i)
+        out[i] = a[i] - b[i];
+}
+
+template<typename T>
+static void scalar_scale(T c, const T* a, T* out, size_t n) {
+    for (size_t i = 0; i < n; ++i)
+        out[i] = c * a[i];
+}
+
+template<typename T>
+static void scalar_axpy(T c, const T* x, T* y, size_t n) {
+    for (size_t i = 0; i < n; ++i)
+        y[i] += c * x[i];
+}
+
+static void scalar_gemm_4x4(size_t kc, const double* a, const double* b, double* c, size_t ldc) {
+    double acc[4][4] = {};
+    for (size_t p = 0; p < kc; ++p, a += 4, b += 4)
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j)
+                acc[i][j] += a[i] * b[j];
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            c[i * ldc + j] += acc[i][j];
+}
+
+static void scalar_histogram_slots(const double* x, size_t n, double lo, double hi, double scale,
+                                   uint32_t bins, uint32_t* out) {
+    const double last = static_cast<double>(bins - 1);
+    for (size_t i = 0; i < n; ++i) {
+        double t = (x[i] - lo) * scale;
+        t = t > 0.0 ? t : 0.0;          // also maps NaN to 0, so the cast is defined
+        t = t < last ? t : last;
+        uint32_t slot = static_cast<uint32_t>(t) + 1;
+        slot = x[i] < lo ? 0 : slot;
+        slot = x[i] > hi ? bins + 1 : slot;
+        slot = x[i] != x[i] ? bins + 2 : slot;
+        out[i] = slot;
+    }
+}
+
+const KernelTable* scalar_kernels() {
+    static const KernelTable table{
+        SimdLevel::Scalar,
+        scalar_dot<double>,
+        scalar_sum_of_squares<double>,
+        scalar_squared_distance<double>,
+        scalar_add<double>,
+        scalar_subtract<double>,
+        scalar_scale<double>,
+        scalar_axpy<double>,
+        4, 4, scalar_gemm_4x4,
+        scalar_histogram_slots,
+        {
+            scalar_dot<float>,
+            scalar_sum_of_squares<float>,
+            scalar_squared_distance<float>,
+            scalar_sum<float>,
+            scalar_centered_dot<float>,
+            scalar_add<float>,
+            scalar_subtract<float>,
+            scalar_scale<float>,
+            scalar_axpy<float>,
+        },
+    };
+    return &table;
+}
+
+// ---------------- Dispatch ----------------
+
+static const KernelTable* table_for(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::AVX512: return avx512_kernels();
+    case SimdLevel::AVX2:   return avx2_kernels();
+    case SimdLevel::SSE2:   return sse2_kernels();
+    case SimdLevel::Scalar: return scalar_kernels();
+    }
+    return scalar_kernels();
+}
+
+static bool cpu_supports(SimdLevel level) {
+#if DS_SIMD_X86
+    switch (level) {
+    case SimdLevel::AVX512: return __builtin_cpu_supports("avx512f");
+    case SimdLevel::AVX2:   return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case SimdLevel::SSE2:   return __builtin_cpu_supports("sse2");
+    case SimdLevel::Scalar: return true;
+    }
+    return false;
+#else
+    return level == SimdLevel::Scalar;
+#endif
+}
+
+static bool usable(SimdLevel level) {
+    return table_for(level) != nullptr && cpu_supports(level);
+}
+
+static SimdLevel parse_level(const char* name, SimdLevel fallback) {
+    if (name == nullptr) return fallback;
+    if (std::strcmp(name, "scalar") == 0) return SimdLevel::Scalar;
+    if (std::strcmp(name, "sse2") == 0)   return SimdLevel::SSE2;
+    if (std::strcmp(name, "avx2") == 0)   return SimdLevel::AVX2;
+    if (std::strcmp(name, "avx512") == 0) return SimdLevel::AVX512;
+    return fallback;
+}
+
+static std::atomic<const KernelTable*> active{nullptr};
+
+const KernelTable& kernels() {
+    const KernelTable* table = active.load(std::memory_order_acquire);
+    if (table == nullptr) {
+        SimdLevel level = parse_level(std::getenv("DS_SIMD"), detected_simd_level());
+        set_simd_level(level);
+        table = active.load(std::memory_order_acquire);
+    }
+    return *table;
+}
+
+} // namespace simd
+
+SimdLevel detected_simd_level() {
+    static const SimdLevel best = [] {
+        for (SimdLevel level : {SimdLevel::AVX512, SimdLevel::AVX2, SimdLevel::SSE2})
+            if (simd::usable(level)) return level;
+        return SimdLevel::Scalar;
+    }();
+    return best;
+}
+
+SimdLevel simd_level() {
+    return simd::kernels().level;
+}
+
+SimdLevel set_simd_level(SimdLevel level) {
+    if (level > detected_simd_level())
+        level = detected_simd_level();
+    // Lower levels may be compiled out on non-x86 builds
+    while (!simd::usable(level))
+        level = static_cast<SimdLevel>(static_cast<int>(level) - 1);
+
+    simd::active.store(simd::table_for(level), std::memory_order_release);
+    return level;
+}
+
+const char* simd_level_name(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::Scalar: return "scalar";
+    case SimdLevel::SSE2:   return "sse2";
+    case SimdLevel::AVX2:   return "avx2";
+    case SimdLevel::AVX512: return "avx512";
+    }
+    return "unknown";
+}
+
+} // namespace ds
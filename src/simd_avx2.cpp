@@ -0,0 +1,295 @@
+#include "simd_kernels.hpp"
+
+#if DS_SIMD_X86
+#include <immintrin.h>
+
+#define DS_TARGET __attribute__((target("avx2,fma")))
+
+namespace ds {
+namespace simd {
+
+// 4 registers x 4 lanes = 16 independent partial sums, accumulated with FMA
+
+DS_TARGET static inline double hsum(__m256d v) {
+    __m128d lo = _mm256_castpd256_pd128(v);
+    __m128d hi = _mm256_extractf128_pd(v, 1);
+    lo = _mm_add_pd(lo, hi);
+    return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+}
+
+DS_TARGET static double avx2_dot(const double* a, const double* b, size_t n) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i),      _mm256_loadu_pd(b + i),      s0);
+        s1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4),  _mm256_loadu_pd(b + i + 4),  s1);
+        s2 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 8),  _mm256_loadu_pd(b + i + 8),  s2);
+        s3 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 12), _mm256_loadu_pd(b + i + 12), s3);
+    }
+    for (; i + 4 <= n; i += 4)
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), s0);
+    double sum = hsum(_mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3)));
+    for (; i < n; ++i)
+        sum += a[i] * b[i];
+    return sum;
+}
+
+DS_TARGET static double avx2_sum_of_squares(const double* a, size_t n) {
+    return avx2_dot(a, a, n);
+}
+
+DS_TARGET static double avx2_squared_distance(const double* a, const double* b, size_t n) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(a + i),      _mm256_loadu_pd(b + i));
+        __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(a + i + 4),  _mm256_loadu_pd(b + i + 4));
+        __m256d d2 = _mm256_sub_pd(_mm256_loadu_pd(a + i + 8),  _mm256_loadu_pd(b + i + 8));
+        __m256d d3 = _mm256_sub_pd(_mm256_loadu_pd(a + i + 12), _mm256_loadu_pd(b + i + 12));
+        s0 = _mm256_fmadd_pd(d0, d0, s0);
+        s1 = _mm256_fmadd_pd(d1, d1, s1);
+        s2 = _mm256_fmadd_pd(d2, d2, s2);
+        s3 = _mm256_fmadd_pd(d3, d3, s3);
+    }
+    for (; i + 4 <= n; i += 4) {
+        __m256d d = _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+        s0 = _mm256_fmadd_pd(d, d, s0);
+    }
+    double sum = hsum(_mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3)));
+    for (; i < n; ++i) {
+        const double d = a[i] - b[i];
+        sum += d * d;
+    }
+    return sum;
+}
+
+DS_TARGET static void avx2_add(const double* a, const double* b, double* out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    for (; i < n; ++i)
+        out[i] = a[i] + b[i];
+}
+
+DS_TARGET static void avx2_subtract(const double* a, const double* b, double* out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(out + i, _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    for (; i < n; ++i)
+        out[i] = a[i] - b[i];
+}
+
+DS_TARGET static void avx2_scale(double c, const double* a, double* out, size_t n) {
+    const __m256d vc = _mm256_set1_pd(c);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(vc, _mm256_loadu_pd(a + i)));
+    for (; i < n; ++i)
+        out[i] = c * a[i];
+}
+
+// Separate multiply and add (not FMA) so axpy stays bitwise identical
+// to the scalar kernel, as promised for elementwise ops in ds/simd.hpp
+DS_TARGET static void avx2_axpy(double c, const double* x, double* y, size_t n) {
+    const __m256d vc = _mm256_set1_pd(c);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_loadu_pd(y + i), _mm256_mul_pd(vc, _mm256_loadu_pd(x + i))));
+    for (; i < n; ++i)
+        y[i] += c * x[i];
+}
+
+// 6 x 8 tile held in 12 registers; 2 loads + 6 broadcasts feed 12 FMAs per k
+DS_TARGET static void avx2_gemm_6x8(size_t kc, const double* a, const double* b, double* c, size_t ldc) {
+    __m256d acc[6][2];
+#pragma GCC unroll 6
+    for (int i = 0; i < 6; ++i)
+        acc[i][0] = acc[i][1] = _mm256_setzero_pd();
+
+    for (size_t p = 0; p < kc; ++p, a += 6, b += 8) {
+        const __m256d b0 = _mm256_loadu_pd(b);
+        const __m256d b1 = _mm256_loadu_pd(b + 4);
+#pragma GCC unroll 6
+        for (int i = 0; i < 6; ++i) {
+            const __m256d ai = _mm256_broadcast_sd(a + i);
+            acc[i][0] = _mm256_fmadd_pd(ai, b0, acc[i][0]);
+            acc[i][1] = _mm256_fmadd_pd(ai, b1, acc[i][1]);
+        }
+    }
+
+#pragma GCC unroll 6
+    for (int i = 0; i < 6; ++i) {
+        double* ci = c + i * ldc;
+        _mm256_storeu_pd(ci,     _mm256_add_pd(_mm256_loadu_pd(ci),     acc[i][0]));
+        _mm256_storeu_pd(ci + 4, _mm256_add_pd(_mm256_loadu_pd(ci + 4), acc[i][1]));
+    }
+}
+
+// ---------------- Float storage ----------------
+// Each group of 4 floats is widened to a __m256d, so reductions keep the
+// same 16 double accumulators as above; only the loads are halved.
+
+namespace {
+
+struct DotOp {
+    DS_TARGET __m256d operator()(__m256d x, __m256d y, __m256d acc) const { return _mm256_fmadd_pd(x, y, acc); }
+    double operator()(double x, double y) const { return x * y; }
+};
+
+struct SumOp {
+    DS_TARGET __m256d operator()(__m256d x, __m256d, __m256d acc) const { return _mm256_add_pd(acc, x); }
+    double operator()(double x, double) const { return x; }
+};
+
+struct SquaredDistanceOp {
+    DS_TARGET __m256d operator()(__m256d x, __m256d y, __m256d acc) const {
+        const __m256d d = _mm256_sub_pd(x, y);
+        return _mm256_fmadd_pd(d, d, acc);
+    }
+    double operator()(double x, double y) const { return (x - y) * (x - y); }
+};
+
+struct CenteredDotOp {
+    double ca, cb;
+    DS_TARGET __m256d operator()(__m256d x, __m256d y, __m256d acc) const {
+        return _mm256_fmadd_pd(_mm256_sub_pd(x, _mm256_set1_pd(ca)), _mm256_sub_pd(y, _mm256_set1_pd(cb)), acc);
+    }
+    double operator()(double x, double y) const { return (x - ca) * (y - cb); }
+};
+
+template<typename Op>
+DS_TARGET double reduce_f32(const float* a, const float* b, size_t n, Op op) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        s0 = op(_mm256_cvtps_pd(_mm_loadu_ps(a + i)),      _mm256_cvtps_pd(_mm_loadu_ps(b + i)),      s0);
+        s1 = op(_mm256_cvtps_pd(_mm_loadu_ps(a + i + 4)),  _mm256_cvtps_pd(_mm_loadu_ps(b + i + 4)),  s1);
+        s2 = op(_mm256_cvtps_pd(_mm_loadu_ps(a + i + 8)),  _mm256_cvtps_pd(_mm_loadu_ps(b + i + 8)),  s2);
+        s3 = op(_mm256_cvtps_pd(_mm_loadu_ps(a + i + 12)), _mm256_cvtps_pd(_mm_loadu_ps(b + i + 12)), s3);
+    }
+    for (; i + 4 <= n; i += 4)
+        s0 = op(_mm256_cvtps_pd(_mm_loadu_ps(a + i)), _mm256_cvtps_pd(_mm_loadu_ps(b + i)), s0);
+    double sum = hsum(_mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3)));
+    for (; i < n; ++i)
+        sum += op(double(a[i]), double(b[i]));
+    return sum;
+}
+
+} // namespace
+
+DS_TARGET static double avx2_dot_f32(const float* a, const float* b, size_t n) {
+    return reduce_f32(a, b, n, DotOp{});
+}
+
+DS_TARGET static double avx2_sum_of_squares_f32(const float* a, size_t n) {
+    return reduce_f32(a, a, n, DotOp{});
+}
+
+DS_TARGET static double avx2_squared_distance_f32(const float* a, const float* b, size_t n) {
+    return reduce_f32(a, b, n, SquaredDistanceOp{});
+}
+
+DS_TARGET static double avx2_sum_f32(const float* a, size_t n) {
+    return reduce_f32(a, a, n, SumOp{});
+}
+
+DS_TARGET static double avx2_centered_dot_f32(const float* a, const float* b, double ca, double cb, size_t n) {
+    return reduce_f32(a, b, n, CenteredDotOp{ca, cb});
+}
+
+DS_TARGET static void avx2_add_f32(const float* a, const float* b, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    for (; i < n; ++i)
+        out[i] = a[i] + b[i];
+}
+
+DS_TARGET static void avx2_subtract_f32(const float* a, const float* b, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(out + i, _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    for (; i < n; ++i)
+        out[i] = a[i] - b[i];
+}
+
+DS_TARGET static void avx2_scale_f32(float c, const float* a, float* out, size_t n) {
+    const __m256 vc = _mm256_set1_ps(c);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(vc, _mm256_loadu_ps(a + i)));
+    for (; i < n; ++i)
+        out[i] = c * a[i];
+}
+
+DS_TARGET static void avx2_axpy_f32(float c, const float* x, float* y, size_t n) {
+    const __m256 vc = _mm256_set1_ps(c);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(vc, _mm256_loadu_ps(x + i))));
+    for (; i < n; ++i)
+        y[i] += c * x[i];
+}
+
+DS_TARGET static void avx2_histogram_slots(const double* x, size_t n, double lo, double hi,
+                                           double scale, uint32_t bins, uint32_t* out) {
+    const __m256d vlo = _mm256_set1_pd(lo), vhi = _mm256_set1_pd(hi), vscale = _mm256_set1_pd(scale);
+    const __m256d zero = _mm256_setzero_pd(), one = _mm256_set1_pd(1.0);
+    const __m256d last = _mm256_set1_pd(bins - 1.0);
+    const __m256d above = _mm256_set1_pd(bins + 1.0), nan_slot = _mm256_set1_pd(bins + 2.0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d v = _mm256_loadu_pd(x + i);
+        __m256d t = _mm256_mul_pd(_mm256_sub_pd(v, vlo), vscale);
+        t = _mm256_min_pd(_mm256_max_pd(t, zero), last);   // max(NaN, 0) = 0
+        __m256d slot = _mm256_add_pd(_mm256_round_pd(t, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC), one);
+        slot = _mm256_blendv_pd(slot, zero, _mm256_cmp_pd(v, vlo, _CMP_LT_OQ));
+        slot = _mm256_blendv_pd(slot, above, _mm256_cmp_pd(v, vhi, _CMP_GT_OQ));
+        slot = _mm256_blendv_pd(slot, nan_slot, _mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_cvttpd_epi32(slot));
+    }
+    scalar_kernels()->histogram_slots(x + i, n - i, lo, hi, scale, bins, out + i);
+}
+
+const KernelTable* avx2_kernels() {
+    static const KernelTable table{
+        SimdLevel::AVX2,
+        avx2_dot,
+        avx2_sum_of_squares,
+        avx2_squared_distance,
+        avx2_add,
+        avx2_subtract,
+        avx2_scale,
+        avx2_axpy,
+        6, 8, avx2_gemm_6x8,
+        avx2_histogram_slots,
+        {
+            avx2_dot_f32,
+            avx2_sum_of_squares_f32,
+            avx2_squared_distance_f32,
+            avx2_sum_f32,
+            avx2_centered_dot_f32,
+            avx2_add_f32,
+            avx2_subtract_f32,
+            avx2_scale_f32,
+            avx2_axpy_f32,
+        },
+    };
+    return &table;
+}
+
+} // namespace simd
+} // namespace ds
+
+#else
+
+namespace ds {
+namespace simd {
+const KernelTable* avx2_kernels() { return nullptr; }
+} // namespace simd
+} // namespace ds
+
+#endif
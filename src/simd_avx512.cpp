@@ -0,0 +1,334 @@
+#include "simd_kernels.hpp"
+
+#if DS_SIMD_X86
+#include <immintrin.h>
+
+#define DS_TARGET __attribute__((target("avx512f")))
+
+namespace ds {
+namespace simd {
+
+// 4 registers x 8 lanes = 32 independent partial sums, accumulated with FMA.
+// Tails use masked loads/stores, so no scalar clean-up loop is needed.
+
+DS_TARGET static inline __mmask8 tail_mask(size_t remaining) {
+    return static_cast<__mmask8>((1u << remaining) - 1u);
+}
+
+DS_TARGET static double avx512_dot(const double* a, const double* b, size_t n) {
+    __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+    __m512d s2 = _mm512_setzero_pd(), s3 = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        s0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i),      _mm512_loadu_pd(b + i),      s0);
+        s1 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 8),  _mm512_loadu_pd(b + i + 8),  s1);
+        s2 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 16), _mm512_loadu_pd(b + i + 16), s2);
+        s3 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 24), _mm512_loadu_pd(b + i + 24), s3);
+    }
+    for (; i + 8 <= n; i += 8)
+        s0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), s0);
+    if (i < n) {
+        const __mmask8 m = tail_mask(n - i);
+        s1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(m, a + i), _mm512_maskz_loadu_pd(m, b + i), s1);
+    }
+    return _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3)));
+}
+
+DS_TARGET static double avx512_sum_of_squares(const double* a, size_t n) {
+    return avx512_dot(a, a, n);
+}
+
+DS_TARGET static double avx512_squared_distance(const double* a, const double* b, size_t n) {
+    __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+    __m512d s2 = _mm512_setzero_pd(), s3 = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m512d d0 = _mm512_sub_pd(_mm512_loadu_pd(a + i),      _mm512_loadu_pd(b + i));
+        __m512d d1 = _mm512_sub_pd(_mm512_loadu_pd(a + i + 8),  _mm512_loadu_pd(b + i + 8));
+        __m512d d2 = _mm512_sub_pd(_mm512_loadu_pd(a + i + 16), _mm512_loadu_pd(b + i + 16));
+        __m512d d3 = _mm512_sub_pd(_mm512_loadu_pd(a + i + 24), _mm512_loadu_pd(b + i + 24));
+        s0 = _mm512_fmadd_pd(d0, d0, s0);
+        s1 = _mm512_fmadd_pd(d1, d1, s1);
+        s2 = _mm512_fmadd_pd(d2, d2, s2);
+        s3 = _mm512_fmadd_pd(d3, d3, s3);
+    }
+    for (; i + 8 <= n; i += 8) {
+        __m512d d = _mm512_sub_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i));
+        s0 = _mm512_fmadd_pd(d, d, s0);
+    }
+    if (i < n) {
+        const __mmask8 m = tail_mask(n - i);
+        __m512d d = _mm512_sub_pd(_mm512_maskz_loadu_pd(m, a + i), _mm512_maskz_loadu_pd(m, b + i));
+        s1 = _mm512_fmadd_pd(d, d, s1);
+    }
+    return _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3)));
+}
+
+DS_TARGET static void avx512_add(const double* a, const double* b, double* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(out + i, _mm512_add_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+    if (i < n) {
+        const __mmask8 m = tail_mask(n - i);
+        _mm512_mask_storeu_pd(out + i, m,
+            _mm512_add_pd(_mm512_maskz_loadu_pd(m, a + i), _mm512_maskz_loadu_pd(m, b + i)));
+    }
+}
+
+DS_TARGET static void avx512_subtract(const double* a, const double* b, double* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(out + i, _mm512_sub_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+    if (i < n) {
+        const __mmask8 m = tail_mask(n - i);
+        _mm512_mask_storeu_pd(out + i, m,
+            _mm512_sub_pd(_mm512_maskz_loadu_pd(m, a + i), _mm512_maskz_loadu_pd(m, b + i)));
+    }
+}
+
+DS_TARGET static void avx512_scale(double c, const double* a, double* out, size_t n) {
+    const __m512d vc = _mm512_set1_pd(c);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(vc, _mm512_loadu_pd(a + i)));
+    if (i < n) {
+        const __mmask8 m = tail_mask(n - i);
+        _mm512_mask_storeu_pd(out + i, m, _mm512_mul_pd(vc, _mm512_maskz_loadu_pd(m, a + i)));
+    }
+}
+
+// Multiply then add (not FMA): bitwise identical to the scalar kernel
+DS_TARGET static void avx512_axpy(double c, const double* x, double* y, size_t n) {
+    const __m512d vc = _mm512_set1_pd(c);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(y + i, _mm512_add_pd(_mm512_loadu_pd(y + i), _mm512_mul_pd(vc, _mm512_loadu_pd(x + i))));
+    if (i < n) {
+        const __mmask8 m = tail_mask(n - i);
+        _mm512_mask_storeu_pd(y + i, m,
+            _mm512_add_pd(_mm512_maskz_loadu_pd(m, y + i), _mm512_mul_pd(vc, _mm512_maskz_loadu_pd(m, x + i))));
+    }
+}
+
+// 8 x 16 tile held in 16 registers
+DS_TARGET static void avx512_gemm_8x16(size_t kc, const double* a, const double* b, double* c, size_t ldc) {
+    __m512d acc[8][2];
+#pragma GCC unroll 8
+    for (int i = 0; i < 8; ++i)
+        acc[i][0] = acc[i][1] = _mm512_setzero_pd();
+
+    for (size_t p = 0; p < kc; ++p, a += 8, b += 16) {
+        const __m512d b0 = _mm512_loadu_pd(b);
+        const __m512d b1 = _mm512_loadu_pd(b + 8);
+#pragma GCC unroll 8
+        for (int i = 0; i < 8; ++i) {
+            const __m512d ai = _mm512_set1_pd(a[i]);
+            acc[i][0] = _mm512_fmadd_pd(ai, b0, acc[i][0]);
+            acc[i][1] = _mm512_fmadd_pd(ai, b1, acc[i][1]);
+        }
+    }
+
+#pragma GCC unroll 8
+    for (int i = 0; i < 8; ++i) {
+        double* ci = c + i * ldc;
+        _mm512_storeu_pd(ci,     _mm512_add_pd(_mm512_loadu_pd(ci),     acc[i][0]));
+        _mm512_storeu_pd(ci + 8, _mm512_add_pd(_mm512_loadu_pd(ci + 8), acc[i][1]));
+    }
+}
+
+// ---------------- Float storage ----------------
+// 16 floats are loaded at a time and widened to two __m512d halves, so
+// reductions keep the same 32 double accumulators as above. Masked-off
+// tail lanes are blended out of the accumulator (zero is not neutral for
+// centered_dot).
+
+namespace {
+
+DS_TARGET inline __m512d widen_lo(__m512 v) {
+    return _mm512_cvtps_pd(_mm512_castps512_ps256(v));
+}
+
+DS_TARGET inline __m512d widen_hi(__m512 v) {
+    return _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(v), 1)));
+}
+
+DS_TARGET inline __mmask16 tail_mask16(size_t remaining) {
+    return static_cast<__mmask16>((1u << remaining) - 1u);
+}
+
+struct DotOp {
+    DS_TARGET __m512d operator()(__m512d x, __m512d y, __m512d acc) const { return _mm512_fmadd_pd(x, y, acc); }
+};
+
+struct SumOp {
+    DS_TARGET __m512d operator()(__m512d x, __m512d, __m512d acc) const { return _mm512_add_pd(acc, x); }
+};
+
+struct SquaredDistanceOp {
+    DS_TARGET __m512d operator()(__m512d x, __m512d y, __m512d acc) const {
+        const __m512d d = _mm512_sub_pd(x, y);
+        return _mm512_fmadd_pd(d, d, acc);
+    }
+};
+
+struct CenteredDotOp {
+    double ca, cb;
+    DS_TARGET __m512d operator()(__m512d x, __m512d y, __m512d acc) const {
+        return _mm512_fmadd_pd(_mm512_sub_pd(x, _mm512_set1_pd(ca)), _mm512_sub_pd(y, _mm512_set1_pd(cb)), acc);
+    }
+};
+
+template<typename Op>
+DS_TARGET double reduce_f32(const float* a, const float* b, size_t n, Op op) {
+    __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+    __m512d s2 = _mm512_setzero_pd(), s3 = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m512 a0 = _mm512_loadu_ps(a + i), a1 = _mm512_loadu_ps(a + i + 16);
+        const __m512 b0 = _mm512_loadu_ps(b + i), b1 = _mm512_loadu_ps(b + i + 16);
+        s0 = op(widen_lo(a0), widen_lo(b0), s0);
+        s1 = op(widen_hi(a0), widen_hi(b0), s1);
+        s2 = op(widen_lo(a1), widen_lo(b1), s2);
+        s3 = op(widen_hi(a1), widen_hi(b1), s3);
+    }
+    for (; i + 16 <= n; i += 16) {
+        const __m512 a0 = _mm512_loadu_ps(a + i), b0 = _mm512_loadu_ps(b + i);
+        s0 = op(widen_lo(a0), widen_lo(b0), s0);
+        s1 = op(widen_hi(a0), widen_hi(b0), s1);
+    }
+    if (i < n) {
+        const __mmask16 m = tail_mask16(n - i);
+        const __m512 a0 = _mm512_maskz_loadu_ps(m, a + i), b0 = _mm512_maskz_loadu_ps(m, b + i);
+        const __mmask8 lo = static_cast<__mmask8>(m), hi = static_cast<__mmask8>(m >> 8);
+        s2 = _mm512_mask_blend_pd(lo, s2, op(widen_lo(a0), widen_lo(b0), s2));
+        s3 = _mm512_mask_blend_pd(hi, s3, op(widen_hi(a0), widen_hi(b0), s3));
+    }
+    return _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3)));
+}
+
+} // namespace
+
+DS_TARGET static double avx512_dot_f32(const float* a, const float* b, size_t n) {
+    return reduce_f32(a, b, n, DotOp{});
+}
+
+DS_TARGET static double avx512_sum_of_squares_f32(const float* a, size_t n) {
+    return reduce_f32(a, a, n, DotOp{});
+}
+
+DS_TARGET static double avx512_squared_distance_f32(const float* a, const float* b, size_t n) {
+    return reduce_f32(a, b, n, SquaredDistanceOp{});
+}
+
+DS_TARGET static double avx512_sum_f32(const float* a, size_t n) {
+    return reduce_f32(a, a, n, SumOp{});
+}
+
+DS_TARGET static double avx512_centered_dot_f32(const float* a, const float* b, double ca, double cb, size_t n) {
+    return reduce_f32(a, b, n, CenteredDotOp{ca, cb});
+}
+
+DS_TARGET static void avx512_add_f32(const float* a, const float* b, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+        _mm512_storeu_ps(out + i, _mm512_add_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+    if (i < n) {
+        const __mmask16 m = tail_mask16(n - i);
+        _mm512_mask_storeu_ps(out + i, m,
+            _mm512_add_ps(_mm512_maskz_loadu_ps(m, a + i), _mm512_maskz_loadu_ps(m, b + i)));
+    }
+}
+
+DS_TARGET static void avx512_subtract_f32(const float* a, const float* b, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+        _mm512_storeu_ps(out + i, _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+    if (i < n) {
+        const __mmask16 m = tail_mask16(n - i);
+        _mm512_mask_storeu_ps(out + i, m,
+            _mm512_sub_ps(_mm512_maskz_loadu_ps(m, a + i), _mm512_maskz_loadu_ps(m, b + i)));
+    }
+}
+
+DS_TARGET static void avx512_scale_f32(float c, const float* a, float* out, size_t n) {
+    const __m512 vc = _mm512_set1_ps(c);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+        _mm512_storeu_ps(out + i, _mm512_mul_ps(vc, _mm512_loadu_ps(a + i)));
+    if (i < n) {
+        const __mmask16 m = tail_mask16(n - i);
+        _mm512_mask_storeu_ps(out + i, m, _mm512_mul_ps(vc, _mm512_maskz_loadu_ps(m, a + i)));
+    }
+}
+
+DS_TARGET static void avx512_axpy_f32(float c, const float* x, float* y, size_t n) {
+    const __m512 vc = _mm512_set1_ps(c);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+        _mm512_storeu_ps(y + i, _mm512_add_ps(_mm512_loadu_ps(y + i), _mm512_mul_ps(vc, _mm512_loadu_ps(x + i))));
+    if (i < n) {
+        const __mmask16 m = tail_mask16(n - i);
+        _mm512_mask_storeu_ps(y + i, m,
+            _mm512_add_ps(_mm512_maskz_loadu_ps(m, y + i), _mm512_mul_ps(vc, _mm512_maskz_loadu_ps(m, x + i))));
+    }
+}
+
+DS_TARGET static void avx512_histogram_slots(const double* x, size_t n, double lo, double hi,
+                                             double scale, uint32_t bins, uint32_t* out) {
+    const __m512d vlo = _mm512_set1_pd(lo), vhi = _mm512_set1_pd(hi), vscale = _mm512_set1_pd(scale);
+    const __m512d zero = _mm512_setzero_pd(), one = _mm512_set1_pd(1.0);
+    const __m512d last = _mm512_set1_pd(bins - 1.0);
+    const __m512d above = _mm512_set1_pd(bins + 1.0), nan_slot = _mm512_set1_pd(bins + 2.0);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m512d v = _mm512_loadu_pd(x + i);
+        __m512d t = _mm512_mul_pd(_mm512_sub_pd(v, vlo), vscale);
+        t = _mm512_min_pd(_mm512_max_pd(t, zero), last);   // max(NaN, 0) = 0
+        __m512d slot = _mm512_add_pd(_mm512_roundscale_pd(t, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC), one);
+        slot = _mm512_mask_mov_pd(slot, _mm512_cmp_pd_mask(v, vlo, _CMP_LT_OQ), zero);
+        slot = _mm512_mask_mov_pd(slot, _mm512_cmp_pd_mask(v, vhi, _CMP_GT_OQ), above);
+        slot = _mm512_mask_mov_pd(slot, _mm512_cmp_pd_mask(v, v, _CMP_UNORD_Q), nan_slot);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm512_cvttpd_epu32(slot));
+    }
+    scalar_kernels()->histogram_slots(x + i, n - i, lo, hi, scale, bins, out + i);
+}
+
+const KernelTable* avx512_kernels() {
+    static const KernelTable table{
+        SimdLevel::AVX512,
+        avx512_dot,
+        avx512_sum_of_squares,
+        avx512_squared_distance,
+        avx512_add,
+        avx512_subtract,
+        avx512_scale,
+        avx512_axpy,
+        8, 16, avx512_gemm_8x16,
+        avx512_histogram_slots,
+        {
+            avx512_dot_f32,
+            avx512_sum_of_squares_f32,
+            avx512_squared_distance_f32,
+            avx512_sum_f32,
+            avx512_centered_dot_f32,
+            avx512_add_f32,
+            avx512_subtract_f32,
+            avx512_scale_f32,
+            avx512_axpy_f32,
+        },
+    };
+    return &table;
+}
+
+} // namespace simd
+} // namespace ds
+
+#else
+
+namespace ds {
+namespace simd {
+const KernelTable* avx512_kernels() { return nullptr; }
+} // namespace simd
+} // namespace ds
+
+#endif
@@ -0,0 +1,78 @@
+#if !defined(__SIMD_KERNELS__)
+#define __SIMD_KERNELS__
+
+// Internal interface between the dispatcher (simd.cpp) and the per-ISA
+// kernel translation units. Not installed; include only from src/.
+
+#include <cstddef>
+#include <cstdint>
+#include "ds/simd.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DS_SIMD_X86 1
+#else
+#define DS_SIMD_X86 0
+#endif
+
+namespace ds {
+namespace simd {
+
+/// Kernels for single-precision storage. Reductions widen every element
+/// to double before multiplying and accumulate in double, so float data
+/// costs half the memory traffic without float-sized rounding error in the
+/// sum. Elementwise kernels compute and store in float.
+struct FloatKernels {
+    double (*dot)(const float* a, const float* b, size_t n);
+    double (*sum_of_squares)(const float* a, size_t n);
+    double (*squared_distance)(const float* a, const float* b, size_t n);
+    double (*sum)(const float* a, size_t n);
+    // sum_i (a_i - ca) * (b_i - cb), the core of variance and covariance
+    double (*centered_dot)(const float* a, const float* b, double ca, double cb, size_t n);
+    void (*add)(const float* a, const float* b, float* out, size_t n);
+    void (*subtract)(const float* a, const float* b, float* out, size_t n);
+    void (*scale)(float c, const float* a, float* out, size_t n);
+    void (*axpy)(float c, const float* x, float* y, size_t n);   // y += c * x
+};
+
+/// One implementation of every dispatched kernel. Elementwise kernels allow
+/// `out` to alias either input exactly (not partially).
+struct KernelTable {
+    SimdLevel level;
+    double (*dot)(const double* a, const double* b, size_t n);
+    double (*sum_of_squares)(const double* a, size_t n);
+    double (*squared_distance)(const double* a, const double* b, size_t n);
+    void (*add)(const double* a, const double* b, double* out, size_t n);
+    void (*subtract)(const double* a, const double* b, double* out, size_t n);
+    void (*scale)(double c, const double* a, double* out, size_t n);
+    void (*axpy)(double c, const double* x, double* y, size_t n);   // y += c * x
+
+    // GEMM micro-kernel: C[mr x nr] += A_panel * B_panel, where A_panel is
+    // packed as kc groups of mr values (one column of the tile per k) and
+    // B_panel as kc groups of nr values (one row of the tile per k).
+    size_t gemm_mr;
+    size_t gemm_nr;
+    void (*gemm_kernel)(size_t kc, const double* a, const double* b, double* c, size_t ldc);
+
+    // Histogram slot of every x for `bins` equal-width bins on [lo, hi],
+    // scale = bins / (hi - lo): 0 below lo, 1 + floor((x - lo) * scale)
+    // inside (hi itself in the last bin), bins + 1 above hi, bins + 2 for
+    // NaN. Branch-free: clamps and selects only.
+    void (*histogram_slots)(const double* x, size_t n, double lo, double hi, double scale,
+                            uint32_t bins, uint32_t* out);
+
+    FloatKernels f32;
+};
+
+// Each returns nullptr when the ISA is not available in this build.
+const KernelTable* scalar_kernels();
+const KernelTable* sse2_kernels();
+const KernelTable* avx2_kernels();
+const KernelTable* avx512_kernels();
+
+/// The table selected by the dispatcher (resolved on first use)
+const KernelTable& kernels();
+
+} // namespace simd
+} // namespace ds
+
+#endif // __SIMD_KERNELS__
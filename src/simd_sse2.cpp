@@ -0,0 +1,157 @@
+#include "simd_kernels.hpp"
+
+#if DS_SIMD_X86
+#include <immintrin.h>
+
+#define DS_TARGET __attribute__((target("sse2")))
+
+namespace ds {
+namespace simd {
+
+// 4 registers x 2 lanes = 8 independent partial sums
+
+DS_TARGET static inline double hsum(__m128d v) {
+    return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+}
+
+DS_TARGET static double sse2_dot(const double* a, const double* b, size_t n) {
+    __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+    __m128d s2 = _mm_setzero_pd(), s3 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(a + i),     _mm_loadu_pd(b + i)));
+        s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+        s2 = _mm_add_pd(s2, _mm_mul_pd(_mm_loadu_pd(a + i + 4), _mm_loadu_pd(b + i + 4)));
+        s3 = _mm_add_pd(s3, _mm_mul_pd(_mm_loadu_pd(a + i + 6), _mm_loadu_pd(b + i + 6)));
+    }
+    for (; i + 2 <= n; i += 2)
+        s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    double sum = hsum(_mm_add_pd(_mm_add_pd(s0, s1), _mm_add_pd(s2, s3)));
+    if (i < n)
+        sum += a[i] * b[i];
+    return sum;
+}
+
+DS_TARGET static double sse2_sum_of_squares(const double* a, size_t n) {
+    return sse2_dot(a, a, n);
+}
+
+DS_TARGET static double sse2_squared_distance(const double* a, const double* b, size_t n) {
+    __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+    __m128d s2 = _mm_setzero_pd(), s3 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128d d0 = _mm_sub_pd(_mm_loadu_pd(a + i),     _mm_loadu_pd(b + i));
+        __m128d d1 = _mm_sub_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2));
+        __m128d d2 = _mm_sub_pd(_mm_loadu_pd(a + i + 4), _mm_loadu_pd(b + i + 4));
+        __m128d d3 = _mm_sub_pd(_mm_loadu_pd(a + i + 6), _mm_loadu_pd(b + i + 6));
+        s0 = _mm_add_pd(s0, _mm_mul_pd(d0, d0));
+        s1 = _mm_add_pd(s1, _mm_mul_pd(d1, d1));
+        s2 = _mm_add_pd(s2, _mm_mul_pd(d2, d2));
+        s3 = _mm_add_pd(s3, _mm_mul_pd(d3, d3));
+    }
+    for (; i + 2 <= n; i += 2) {
+        __m128d d = _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i));
+        s0 = _mm_add_pd(s0, _mm_mul_pd(d, d));
+    }
+    double sum = hsum(_mm_add_pd(_mm_add_pd(s0, s1), _mm_add_pd(s2, s3)));
+    if (i < n) {
+        const double d = a[i] - b[i];
+        sum += d * d;
+    }
+    return sum;
+}
+
+DS_TARGET static void sse2_add(const double* a, const double* b, double* out, size_t n) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+        _mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    if (i < n)
+        out[i] = a[i] + b[i];
+}
+
+DS_TARGET static void sse2_subtract(const double* a, const double* b, double* out, size_t n) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+        _mm_storeu_pd(out + i, _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    if (i < n)
+        out[i] = a[i] - b[i];
+}
+
+DS_TARGET static void sse2_scale(double c, const double* a, double* out, size_t n) {
+    const __m128d vc = _mm_set1_pd(c);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+        _mm_storeu_pd(out + i, _mm_mul_pd(vc, _mm_loadu_pd(a + i)));
+    if (i < n)
+        out[i] = c * a[i];
+}
+
+DS_TARGET static void sse2_axpy(double c, const double* x, double* y, size_t n) {
+    const __m128d vc = _mm_set1_pd(c);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+        _mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i), _mm_mul_pd(vc, _mm_loadu_pd(x + i))));
+    if (i < n)
+        y[i] += c * x[i];
+}
+
+// 4 x 4 tile held in 8 registers
+DS_TARGET static void sse2_gemm_4x4(size_t kc, const double* a, const double* b, double* c, size_t ldc) {
+    __m128d acc[4][2];
+#pragma GCC unroll 4
+    for (int i = 0; i < 4; ++i)
+        acc[i][0] = acc[i][1] = _mm_setzero_pd();
+
+    for (size_t p = 0; p < kc; ++p, a += 4, b += 4) {
+        const __m128d b0 = _mm_loadu_pd(b);
+        const __m128d b1 = _mm_loadu_pd(b + 2);
+#pragma GCC unroll 4
+        for (int i = 0; i < 4; ++i) {
+            const __m128d ai = _mm_set1_pd(a[i]);
+            acc[i][0] = _mm_add_pd(acc[i][0], _mm_mul_pd(ai, b0));
+            acc[i][1] = _mm_add_pd(acc[i][1], _mm_mul_pd(ai, b1));
+        }
+    }
+
+#pragma GCC unroll 4
+    for (int i = 0; i < 4; ++i) {
+        double* ci = c + i * ldc;
+        _mm_storeu_pd(ci,     _mm_add_pd(_mm_loadu_pd(ci),     acc[i][0]));
+        _mm_storeu_pd(ci + 2, _mm_add_pd(_mm_loadu_pd(ci + 2), acc[i][1]));
+    }
+}
+
+const KernelTable* sse2_kernels() {
+    static const KernelTable table{
+        SimdLevel::SSE2,
+        sse2_dot,
+        sse2_sum_of_squares,
+        sse2_squared_distance,
+        sse2_add,
+        sse2_subtract,
+        sse2_scale,
+        sse2_axpy,
+        4, 4, sse2_gemm_4x4,
+        // no SSE2 round/blend instructions: the scalar selects compile to
+        // the same conditional moves
+        scalar_kernels()->histogram_slots,
+        // Widening float -> double leaves only two lanes per SSE2 register,
+        // so the (compiler-vectorized) scalar float kernels are as fast
+        scalar_kernels()->f32,
+    };
+    return &table;
+}
+
+} // namespace simd
+} // namespace ds
+
+#else
+
+namespace ds {
+namespace simd {
+const KernelTable* sse2_kernels() { return nullptr; }
+} // namespace simd
+} // namespace ds
+
+#endif
@@ -0,0 +1,362 @@
+#include "ds/sketches.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+namespace ds {
+namespace {
+
+constexpr double kShrink = 2.0 / 3.0;   // capacity ratio between adjacent levels
+
+// (value, weight) pairs in ascending order with cumulative weights
+struct SortedView {
+    std::vector<double> values;
+    std::vector<uint64_t> cumulative;   // total weight of values[0..i]
+};
+
+SortedView sorted_view(const std::vector<Vector>& levels) {
+    std::vector<std::pair<double, uint64_t>> items;
+    for (size_t h = 0; h < levels.size(); ++h)
+        for (double v : levels[h])
+            items.emplace_back(v, uint64_t(1) << h);
+    std::sort(items.begin(), items.end());
+
+    SortedView view;
+    view.values.reserve(items.size());
+    view.cumulative.reserve(items.size());
+    uint64_t total = 0;
+    for (const auto& item : items) {
+        total += item.second;
+        view.values.push_back(item.first);
+        view.cumulative.push_back(total);
+    }
+    return view;
+}
+
+// Value whose 0-based weighted rank range covers floor(p * n)
+double quantile_from(const SortedView& view, size_t n, double lo, double hi, double p) {
+    assert(n > 0 && p >= 0.0 && p <= 1.0);
+    if (p == 0.0) return lo;
+    if (p == 1.0) return hi;
+    const uint64_t r = std::min<uint64_t>(n - 1, static_cast<uint64_t>(p * n));
+    auto it = std::upper_bound(view.cumulative.begin(), view.cumulative.end(), r);
+    if (it == view.cumulative.end()) return hi;
+    return view.values[it - view.cumulative.begin()];
+}
+
+} // namespace
+
+QuantileSketch::QuantileSketch(size_t k) : k_(k), levels_(1) {
+    assert(k >= 8);
+    update_capacity();
+}
+
+size_t QuantileSketch::capacity(size_t level) const {
+    const size_t depth = levels_.size() - 1 - level;
+    const double c = std::ceil(k_ * std::pow(kShrink, static_cast<double>(depth)));
+    return std::max<size_t>(2, static_cast<size_t>(c));
+}
+
+void QuantileSketch::update_capacity() {
+    capacity_ = 0;
+    for (size_t h = 0; h < levels_.size(); ++h)
+        capacity_ += capacity(h);
+}
+
+void QuantileSketch::compress() {
+    while (retained_ >= capacity_) {
+        // Compact the lowest full level into the one above it (one exists,
+        // since the levels together hold at least their total capacity)
+        size_t h = 0;
+        while (levels_[h].size() < capacity(h)) ++h;
+        if (h + 1 == levels_.size()) {
+            levels_.emplace_back();
+            update_capacity();
+        }
+
+        Vector& level = levels_[h];
+        Vector& above = levels_[h + 1];
+
+        // An odd item out stays behind at this level
+        const bool odd = level.size() % 2 == 1;
+        double held = 0.0;
+        if (odd) {
+            held = level.back();
+            level.pop_back();
+        }
+
+        rng_ ^= rng_ << 13;
+        rng_ ^= rng_ >> 7;
+        rng_ ^= rng_ << 17;
+        const size_t offset = rng_ & 1;
+
+        std::sort(level.begin(), level.end());
+        for (size_t i = offset; i < level.size(); i += 2)
+            above.push_back(level[i]);
+        retained_ -= level.size() / 2;
+
+        level.clear();
+        if (odd) level.push_back(held);
+    }
+}
+
+void QuantileSketch::push(double x) {
+    ++count_;
+    min_ = std::min(min_, x);
+    max_ = std::max(max_, x);
+    levels_[0].push_back(x);
+    if (++retained_ >= capacity_) compress();
+}
+
+void QuantileSketch::push(ConstVectorSpan xs) {
+    for (double x : xs) push(x);
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    assert(k_ == other.k_);
+    if (other.count_ == 0) return;
+    if (levels_.size() < other.levels_.size()) {
+        levels_.resize(other.levels_.size());
+        update_capacity();
+    }
+    for (size_t h = 0; h < other.levels_.size(); ++h)
+        levels_[h].insert(levels_[h].end(), other.levels_[h].begin(), other.levels_[h].end());
+
+    count_ += other.count_;
+    retained_ += other.retained_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    compress();
+}
+
+double QuantileSketch::quantile(double p) const {
+    return quantile_from(sorted_view(levels_), count_, min_, max_, p);
+}
+
+Vector QuantileSketch::quantiles(const Vector& ps) const {
+    const SortedView view = sorted_view(levels_);
+    Vector result(ps.size());
+    for (size_t i = 0; i < ps.size(); ++i)
+        result[i] = quantile_from(view, count_, min_, max_, ps[i]);
+    return result;
+}
+
+double QuantileSketch::median() const {
+    return quantile(0.5);
+}
+
+double QuantileSketch::interquartile_range() const {
+    const Vector q = quantiles({0.25, 0.75});
+    return q[1] - q[0];
+}
+
+double QuantileSketch::rank(double x) const {
+    if (count_ == 0) return 0.0;
+    uint64_t below = 0;
+    for (size_t h = 0; h < levels_.size(); ++h)
+        for (double v : levels_[h])
+            if (v <= x) below += uint64_t(1) << h;
+    return static_cast<double>(below) / count_;
+}
+
+// ---------------- HeavyHitters ----------------
+
+HeavyHitters::HeavyHitters(size_t capacity) : capacity_(capacity) {
+    assert(capacity >= 1);
+    size_t slots = 4;
+    while (slots < 4 * capacity) slots *= 2;   // load factor <= 1/4
+    slots_.assign(slots, 0);
+    heap_.reserve(capacity);
+}
+
+size_t HeavyHitters::find_slot(uint64_t key) const {
+    const size_t mask = slots_.size() - 1;
+    size_t slot = detail::hash_key(key) & mask;
+    while (slots_[slot] != 0 && detail::value_key(heap_[slots_[slot] - 1].value) != key)
+        slot = (slot + 1) & mask;
+    return slot;
+}
+
+// Backward-shift deletion: later members of the probe run move up so no
+// tombstones are needed
+void HeavyHitters::erase_slot(size_t slot) {
+    const size_t mask = slots_.size() - 1;
+    size_t hole = slot;
+    for (size_t next = (hole + 1) & mask; slots_[next] != 0; next = (next + 1) & mask) {
+        const size_t home = detail::hash_key(detail::value_key(heap_[slots_[next] - 1].value)) & mask;
+        // move next into the hole unless its home lies cyclically in (hole, next]
+        const bool stays = hole <= next ? (hole < home && home <= next)
+                                        : (hole < home || home <= next);
+        if (!stays) {
+            slots_[hole] = slots_[next];
+            hole = next;
+        }
+    }
+    slots_[hole] = 0;
+}
+
+void HeavyHitters::swap_items(size_t a, size_t b) {
+    slots_[find_slot(detail::value_key(heap_[a].value))] = static_cast<uint32_t>(b + 1);
+    slots_[find_slot(detail::value_key(heap_[b].value))] = static_cast<uint32_t>(a + 1);
+    std::swap(heap_[a], heap_[b]);
+}
+
+void HeavyHitters::sift_down(size_t i) {
+    for (;;) {
+        size_t smallest = i;
+        const size_t l = 2 * i + 1, r = l + 1;
+        if (l < heap_.size() && heap_[l].count < heap_[smallest].count) smallest = l;
+        if (r < heap_.size() && heap_[r].count < heap_[smallest].count) smallest = r;
+        if (smallest == i) return;
+        swap_items(i, smallest);
+        i = smallest;
+    }
+}
+
+void HeavyHitters::rebuild_slots() {
+    std::fill(slots_.begin(), slots_.end(), 0);
+    for (size_t i = 0; i < heap_.size(); ++i)
+        slots_[find_slot(detail::value_key(heap_[i].value))] = static_cast<uint32_t>(i + 1);
+}
+
+void HeavyHitters::push(double x) {
+    ++count_;
+    const uint64_t key = detail::value_key(x);
+    const size_t slot = find_slot(key);
+
+    if (slots_[slot] != 0) {
+        const size_t i = slots_[slot] - 1;
+        ++heap_[i].count;
+        sift_down(i);
+    } else if (heap_.size() < capacity_) {
+        // a new item with count 1 is never larger than its parent
+        heap_.push_back({x, 1, 0});
+        slots_[slot] = static_cast<uint32_t>(heap_.size());
+        for (size_t i = heap_.size() - 1; i > 0 && heap_[(i - 1) / 2].count > heap_[i].count; i = (i - 1) / 2)
+            swap_items(i, (i - 1) / 2);
+    } else {
+        // take over the least frequent counter
+        erase_slot(find_slot(detail::value_key(heap_[0].value)));
+        Item& min = heap_[0];
+        min.value = x;
+        min.error = min.count;
+        ++min.count;
+        slots_[find_slot(key)] = 1;
+        sift_down(0);
+    }
+}
+
+void HeavyHitters::push(ConstVectorSpan xs) {
+    for (double x : xs) push(x);
+}
+
+void HeavyHitters::merge(const HeavyHitters& other) {
+    assert(capacity_ == other.capacity_);
+    if (other.count_ == 0) return;
+
+    // a value a full summary does not track may still have occurred up to
+    // its minimum count times
+    const uint64_t min_a = heap_.size() == capacity_ ? heap_[0].count : 0;
+    const uint64_t min_b = other.heap_.size() == other.capacity_ ? other.heap_[0].count : 0;
+
+    struct Entry {
+        uint64_t key;
+        bool mine;   // tracked by this summary (else by other)
+        Item item;
+    };
+    std::vector<Entry> all;
+    all.reserve(heap_.size() + other.heap_.size());
+    for (const Item& item : heap_)
+        all.push_back({detail::value_key(item.value), true, item});
+    for (const Item& item : other.heap_)
+        all.push_back({detail::value_key(item.value), false, item});
+    std::sort(all.begin(), all.end(),
+              [](const Entry& a, const Entry& b) { return a.key < b.key; });
+
+    std::vector<Item> combined;
+    for (size_t i = 0; i < all.size();) {
+        Item item = all[i].item;
+        if (i + 1 < all.size() && all[i + 1].key == all[i].key) {
+            item.count += all[i + 1].item.count;
+            item.error += all[i + 1].item.error;
+            i += 2;
+        } else {
+            // only one side tracks it: charge the other side's minimum
+            const uint64_t missing = all[i].mine ? min_b : min_a;
+            item.count += missing;
+            item.error += missing;
+            ++i;
+        }
+        combined.push_back(item);
+    }
+
+    const size_t keep = std::min(capacity_, combined.size());
+    std::partial_sort(combined.begin(), combined.begin() + keep, combined.end(),
+                      [](const Item& a, const Item& b) { return a.count > b.count; });
+    combined.resize(keep);
+    std::make_heap(combined.begin(), combined.end(),
+                   [](const Item& a, const Item& b) { return a.count > b.count; });
+
+    heap_ = std::move(combined);
+    count_ += other.count_;
+    rebuild_slots();
+}
+
+std::vector<HeavyHitters::Item> HeavyHitters::top(size_t k) const {
+    std::vector<Item> items = heap_;
+    std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+        return a.count != b.count ? a.count > b.count : a.value < b.value;
+    });
+    if (items.size() > k) items.resize(k);
+    return items;
+}
+
+Vector HeavyHitters::mode() const {
+    Vector modes;
+    uint64_t best = 0;
+    for (const Item& item : heap_) best = std::max(best, item.count);
+    for (const Item& item : heap_)
+        if (item.count == best) modes.push_back(item.value);
+    std::sort(modes.begin(), modes.end());
+    return modes;
+}
+
+// ---------------- CountMinSketch ----------------
+
+CountMinSketch::CountMinSketch(size_t width, size_t depth)
+    : width_(width), depth_(depth), table_(width * depth, 0) {
+    assert(width >= 1 && depth >= 1);
+}
+
+// Row r uses h1 + r * h2 from one 64-bit hash (Kirsch & Mitzenmacher), so
+// a value is hashed once however deep the table is
+void CountMinSketch::push(double x, uint64_t times) {
+    count_ += times;
+    const uint64_t h = detail::hash_key(detail::value_key(x));
+    const uint64_t h1 = h & 0xffffffffu, h2 = (h >> 32) | 1;
+    for (size_t r = 0; r < depth_; ++r)
+        table_[r * width_ + (h1 + r * h2) % width_] += times;
+}
+
+void CountMinSketch::push(ConstVectorSpan xs) {
+    for (double x : xs) push(x);
+}
+
+void CountMinSketch::merge(const CountMinSketch& other) {
+    assert(width_ == other.width_ && depth_ == other.depth_);
+    for (size_t i = 0; i < table_.size(); ++i)
+        table_[i] += other.table_[i];
+    count_ += other.count_;
+}
+
+uint64_t CountMinSketch::estimate(double x) const {
+    const uint64_t h = detail::hash_key(detail::value_key(x));
+    const uint64_t h1 = h & 0xffffffffu, h2 = (h >> 32) | 1;
+    uint64_t best = std::numeric_limits<uint64_t>::max();
+    for (size_t r = 0; r < depth_; ++r)
+        best = std::min(best, table_[r * width_ + (h1 + r * h2) % width_]);
+    return best;
+}
+
+} // namespace ds
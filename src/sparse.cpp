@@ -0,0 +1,398 @@
+#include "ds/sparse.hpp"
+#include "ds/parallel.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+
+namespace ds {
+namespace {
+
+// Walk the union of two sorted index lists, calling f(index, x_value,
+// y_value) with 0 for the side that has no entry at that index.
+template<typename F>
+void merge_union(SparseView x, SparseView y, F f) {
+    size_t i = 0, j = 0;
+    while (i < x.nnz() && j < y.nnz()) {
+        if (x.indices[i] < y.indices[j]) {
+            f(x.indices[i], x.values[i], 0.0);
+            ++i;
+        } else if (y.indices[j] < x.indices[i]) {
+            f(y.indices[j], 0.0, y.values[j]);
+            ++j;
+        } else {
+            f(x.indices[i], x.values[i], y.values[j]);
+            ++i;
+            ++j;
+        }
+    }
+    for (; i < x.nnz(); ++i) f(x.indices[i], x.values[i], 0.0);
+    for (; j < y.nnz(); ++j) f(y.indices[j], 0.0, y.values[j]);
+}
+
+template<typename Op>
+SparseVector combine(SparseView x, SparseView y, Op op) {
+    assert(x.dim == y.dim);
+    SparseVector result(x.dim);
+    result.reserve(x.nnz() + y.nnz());
+    merge_union(x, y, [&](size_t i, double a, double b) { result.push_back(i, op(a, b)); });
+    return result;
+}
+
+// Counting-sort transpose of a compressed matrix: turns (major x minor)
+// CSR arrays into CSC arrays and vice versa. Entries of each output line
+// come out sorted because the input lines are visited in order.
+void compressed_transpose(size_t major, size_t minor,
+                          const std::vector<size_t>& ptr, const std::vector<size_t>& idx,
+                          const Vector& val, std::vector<size_t>& out_ptr,
+                          std::vector<size_t>& out_idx, Vector& out_val) {
+    out_ptr.assign(minor + 1, 0);
+    out_idx.resize(idx.size());
+    out_val.resize(val.size());
+
+    for (size_t k = 0; k < idx.size(); ++k)
+        ++out_ptr[idx[k] + 1];
+    std::partial_sum(out_ptr.begin(), out_ptr.end(), out_ptr.begin());
+
+    std::vector<size_t> next(out_ptr.begin(), out_ptr.end() - 1);
+    for (size_t i = 0; i < major; ++i) {
+        for (size_t k = ptr[i]; k < ptr[i + 1]; ++k) {
+            const size_t dst = next[idx[k]]++;
+            out_idx[dst] = i;
+            out_val[dst] = val[k];
+        }
+    }
+}
+
+[[maybe_unused]] bool valid_compressed(size_t major, size_t minor, const std::vector<size_t>& ptr,
+                      const std::vector<size_t>& idx, const Vector& val) {
+    if (ptr.size() != major + 1 || ptr.front() != 0 || ptr.back() != idx.size() ||
+        idx.size() != val.size())
+        return false;
+    for (size_t i = 0; i < major; ++i) {
+        if (ptr[i] > ptr[i + 1]) return false;
+        for (size_t k = ptr[i]; k < ptr[i + 1]; ++k)
+            if (idx[k] >= minor || (k > ptr[i] && idx[k] <= idx[k - 1])) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+// ---------------- Sparse vectors ----------------
+
+SparseVector::SparseVector(size_t dim, std::vector<size_t> indices, Vector values) : dim_(dim) {
+    assert(indices.size() == values.size());
+
+    std::vector<size_t> order(indices.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::sort(order.begin(), order.end(),
+              [&](size_t a, size_t b) { return indices[a] < indices[b]; });
+
+    reserve(indices.size());
+    for (size_t k : order) {
+        assert(indices[k] < dim);
+        if (!indices_.empty() && indices_.back() == indices[k])
+            values_.back() += values[k];
+        else
+            push_back(indices[k], values[k]);
+    }
+}
+
+SparseVector to_sparse(ConstVectorSpan v) {
+    SparseVector result(v.size());
+    for (size_t i = 0; i < v.size(); ++i)
+        if (v[i] != 0.0) result.push_back(i, v[i]);
+    return result;
+}
+
+Vector to_dense(SparseView x) {
+    Vector result(x.dim, 0.0);
+    for (size_t k = 0; k < x.nnz(); ++k)
+        result[x.indices[k]] = x.values[k];
+    return result;
+}
+
+double dot(SparseView x, ConstVectorSpan y) {
+    assert(x.dim == y.size());
+    double sum = 0.0;
+    for (size_t k = 0; k < x.nnz(); ++k)
+        sum += x.values[k] * y.data()[x.indices[k]];
+    return sum;
+}
+
+double dot(ConstVectorSpan x, SparseView y) {
+    return dot(y, x);
+}
+
+double dot(SparseView x, SparseView y) {
+    assert(x.dim == y.dim);
+    if (x.nnz() > y.nnz()) std::swap(x, y);
+
+    // Very unbalanced operands (a short query against a long document):
+    // binary-search each index of the short side instead of merging
+    if (x.nnz() * 16 < y.nnz()) {
+        double sum = 0.0;
+        const size_t* pos = y.indices.begin();
+        for (size_t k = 0; k < x.nnz(); ++k) {
+            pos = std::lower_bound(pos, y.indices.end(), x.indices[k]);
+            if (pos == y.indices.end()) break;
+            if (*pos == x.indices[k]) sum += x.values[k] * y.values[pos - y.indices.begin()];
+        }
+        return sum;
+    }
+
+    double sum = 0.0;
+    size_t i = 0, j = 0;
+    while (i < x.nnz() && j < y.nnz()) {
+        if (x.indices[i] < y.indices[j]) {
+            ++i;
+        } else if (y.indices[j] < x.indices[i]) {
+            ++j;
+        } else {
+            sum += x.values[i++] * y.values[j++];
+        }
+    }
+    return sum;
+}
+
+double sum_of_squares(SparseView x) {
+    return sum_of_squares(x.values);
+}
+
+double magnitude(SparseView x) {
+    return std::sqrt(sum_of_squares(x));
+}
+
+double squared_distance(SparseView x, SparseView y) {
+    assert(x.dim == y.dim);
+    double sum = 0.0;
+    merge_union(x, y, [&](size_t, double a, double b) { sum += (a - b) * (a - b); });
+    return sum;
+}
+
+double squared_distance(SparseView x, ConstVectorSpan y) {
+    assert(x.dim == y.size());
+    // (x_i - y_i)^2 at the non-zeros of x and y_i^2 over the gaps between
+    // them (a dense kernel per gap); no term is added and then taken back
+    double sum = 0.0;
+    size_t next = 0;
+    for (size_t k = 0; k < x.nnz(); ++k) {
+        const size_t i = x.indices[k];
+        sum += sum_of_squares(y.subspan(next, i - next));
+        const double d = x.values[k] - y[i];
+        sum += d * d;
+        next = i + 1;
+    }
+    return sum + sum_of_squares(y.subspan(next, y.size() - next));
+}
+
+double squared_distance(ConstVectorSpan x, SparseView y) {
+    return squared_distance(y, x);
+}
+
+SparseVector add(SparseView x, SparseView y) {
+    return combine(x, y, [](double a, double b) { return a + b; });
+}
+
+SparseVector subtract(SparseView x, SparseView y) {
+    return combine(x, y, [](double a, double b) { return a - b; });
+}
+
+SparseVector scalar_multiply(double c, SparseView x) {
+    SparseVector result(x.dim);
+    result.reserve(x.nnz());
+    for (size_t k = 0; k < x.nnz(); ++k)
+        result.push_back(x.indices[k], c * x.values[k]);
+    return result;
+}
+
+void axpy(double a, SparseView x, VectorSpan y) {
+    assert(x.dim == y.size());
+    for (size_t k = 0; k < x.nnz(); ++k)
+        y.data()[x.indices[k]] += a * x.values[k];
+}
+
+void axpy(double a, SparseView x, SparseVector& y) {
+    y = combine(x, y, [a](double xv, double yv) { return yv + a * xv; });
+}
+
+// ---------------- Compressed matrices ----------------
+
+CsrMatrix::CsrMatrix(size_t rows, size_t cols, std::vector<size_t> row_ptr,
+                     std::vector<size_t> col_idx, Vector values)
+    : rows_(rows), cols_(cols), row_ptr_(std::move(row_ptr)),
+      col_idx_(std::move(col_idx)), values_(std::move(values)) {
+    assert(valid_compressed(rows_, cols_, row_ptr_, col_idx_, values_));
+}
+
+CscMatrix::CscMatrix(size_t rows, size_t cols, std::vector<size_t> col_ptr,
+                     std::vector<size_t> row_idx, Vector values)
+    : rows_(rows), cols_(cols), col_ptr_(std::move(col_ptr)),
+      row_idx_(std::move(row_idx)), values_(std::move(values)) {
+    assert(valid_compressed(cols_, rows_, col_ptr_, row_idx_, values_));
+}
+
+CsrMatrix make_csr(size_t rows, size_t cols, const std::vector<Triplet>& entries) {
+    // Bucket by row (counting sort), then sort each row by column and sum
+    // duplicates in place
+    std::vector<size_t> row_ptr(rows + 1, 0);
+    for (const Triplet& t : entries) {
+        assert(t.row < rows && t.col < cols);
+        ++row_ptr[t.row + 1];
+    }
+    std::partial_sum(row_ptr.begin(), row_ptr.end(), row_ptr.begin());
+
+    std::vector<std::pair<size_t, double>> bucketed(entries.size());
+    std::vector<size_t> next(row_ptr.begin(), row_ptr.end() - 1);
+    for (const Triplet& t : entries)
+        bucketed[next[t.row]++] = {t.col, t.value};
+
+    std::vector<size_t> col_idx;
+    Vector values;
+    col_idx.reserve(entries.size());
+    values.reserve(entries.size());
+
+    std::vector<size_t> out_ptr(rows + 1, 0);
+    for (size_t i = 0; i < rows; ++i) {
+        auto first = bucketed.begin() + row_ptr[i];
+        auto last = bucketed.begin() + row_ptr[i + 1];
+        std::sort(first, last, [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (auto it = first; it != last; ++it) {
+            if (col_idx.size() > out_ptr[i] && col_idx.back() == it->first) {
+                values.back() += it->second;
+            } else {
+                col_idx.push_back(it->first);
+                values.push_back(it->second);
+            }
+        }
+        out_ptr[i + 1] = col_idx.size();
+    }
+    return CsrMatrix(rows, cols, std::move(out_ptr), std::move(col_idx), std::move(values));
+}
+
+CsrMatrix make_csr(const std::vector<SparseVector>& rows) {
+    const size_t cols = rows.empty() ? 0 : rows.front().dim();
+    std::vector<size_t> row_ptr(rows.size() + 1, 0);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        assert(rows[i].dim() == cols);
+        row_ptr[i + 1] = row_ptr[i] + rows[i].nnz();
+    }
+
+    std::vector<size_t> col_idx;
+    Vector values;
+    col_idx.reserve(row_ptr.back());
+    values.reserve(row_ptr.back());
+    for (const SparseVector& r : rows) {
+        col_idx.insert(col_idx.end(), r.indices().begin(), r.indices().end());
+        values.insert(values.end(), r.values().begin(), r.values().end());
+    }
+    return CsrMatrix(rows.size(), cols, std::move(row_ptr), std::move(col_idx), std::move(values));
+}
+
+CsrMatrix to_csr(ConstMatrixView A) {
+    std::vector<size_t> row_ptr(A.rows() + 1, 0);
+    std::vector<size_t> col_idx;
+    Vector values;
+    for (size_t i = 0; i < A.rows(); ++i) {
+        for (size_t j = 0; j < A.cols(); ++j) {
+            if (A(i, j) != 0.0) {
+                col_idx.push_back(j);
+                values.push_back(A(i, j));
+            }
+        }
+        row_ptr[i + 1] = col_idx.size();
+    }
+    return CsrMatrix(A.rows(), A.cols(), std::move(row_ptr), std::move(col_idx), std::move(values));
+}
+
+CscMatrix to_csc(const CsrMatrix& A) {
+    std::vector<size_t> col_ptr, row_idx;
+    Vector values;
+    compressed_transpose(A.rows(), A.cols(), A.row_ptr(), A.col_idx(), A.values(),
+                         col_ptr, row_idx, values);
+    return CscMatrix(A.rows(), A.cols(), std::move(col_ptr), std::move(row_idx), std::move(values));
+}
+
+CsrMatrix to_csr(const CscMatrix& A) {
+    std::vector<size_t> row_ptr, col_idx;
+    Vector values;
+    compressed_transpose(A.cols(), A.rows(), A.col_ptr(), A.row_idx(), A.values(),
+                         row_ptr, col_idx, values);
+    return CsrMatrix(A.rows(), A.cols(), std::move(row_ptr), std::move(col_idx), std::move(values));
+}
+
+DenseMatrix to_dense(const CsrMatrix& A) {
+    DenseMatrix result(A.rows(), A.cols());
+    for (size_t i = 0; i < A.rows(); ++i) {
+        SparseView r = A.row(i);
+        for (size_t k = 0; k < r.nnz(); ++k)
+            result(i, r.indices[k]) = r.values[k];
+    }
+    return result;
+}
+
+DenseMatrix to_dense(const CscMatrix& A) {
+    DenseMatrix result(A.rows(), A.cols());
+    for (size_t j = 0; j < A.cols(); ++j) {
+        SparseView c = A.column(j);
+        for (size_t k = 0; k < c.nnz(); ++k)
+            result(c.indices[k], j) = c.values[k];
+    }
+    return result;
+}
+
+// ---------------- Sparse matrix-vector products ----------------
+
+void gemv(double alpha, const CsrMatrix& A, ConstVectorSpan x, double beta, VectorSpan y) {
+    assert(A.cols() == x.size());
+    assert(A.rows() == y.size());
+
+    // Rows are independent, so split them over threads by average work
+    const size_t avg_nnz = A.rows() == 0 ? 1 : std::max<size_t>(1, A.nnz() / A.rows());
+    const size_t min_rows = std::max<size_t>(1, 32768 / avg_nnz);
+
+    parallel_for(0, A.rows(), min_rows, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            const double ax = alpha * dot(A.row(i), x);
+            y[i] = (beta == 0.0) ? ax : ax + beta * y[i];
+        }
+    });
+}
+
+void gemv(double alpha, const CscMatrix& A, ConstVectorSpan x, double beta, VectorSpan y) {
+    assert(A.cols() == x.size());
+    assert(A.rows() == y.size());
+
+    // Column j scatters alpha * x[j] * A(:, j) into y; serial because
+    // columns write to overlapping rows of y
+    if (beta == 0.0)
+        std::fill(y.begin(), y.end(), 0.0);
+    else if (beta != 1.0)
+        scal(beta, y);
+
+    for (size_t j = 0; j < A.cols(); ++j)
+        if (x[j] != 0.0) axpy(alpha * x[j], A.column(j), y);
+}
+
+Vector matvec(const CsrMatrix& A, const Vector& x) {
+    Vector y(A.rows());
+    gemv(1.0, A, x, 0.0, y);
+    return y;
+}
+
+Vector matvec(const CscMatrix& A, const Vector& x) {
+    Vector y(A.rows());
+    gemv(1.0, A, x, 0.0, y);
+    return y;
+}
+
+Vector matvec_transpose(const CsrMatrix& A, const Vector& x) {
+    assert(A.rows() == x.size());
+    Vector y(A.cols(), 0.0);
+    for (size_t i = 0; i < A.rows(); ++i)
+        if (x[i] != 0.0) axpy(x[i], A.row(i), y);
+    return y;
+}
+
+} // namespace ds
@@ -1,59 +1,213 @@
 #include "ds/statistics.hpp"
-#include <unordered_map>
 #include <ds/linear_algebra.hpp>
+#include "ds/accumulators.hpp"
+#include "ds/arena.hpp"
+#include "ds/sketches.hpp"
+#include "simd_kernels.hpp"
 #include <vector> 
 #include <cassert>
 #include <math.h>
 #include <algorithm> // for std::sort
+#include <cstring>
+#include <limits>
 namespace ds {
    double mean(const Vector& v) {
+       return mean(ConstVectorSpan(v));
+   }
+
+   double mean(ConstVectorSpan v) {
        double sum = 0.0;
        for (double x : v)
            sum += x;
        return sum / v.size();
    } 
+   // ---------------- order statistics ----------------
+   // Selection instead of sorting: std::nth_element (introselect, O(n)) on
+   // a scratch copy. Several ranks share one copy and their partitioning:
+   // selecting the middle requested rank splits the data, and the ranks on
+   // each side are then selected inside their own part only, O(n log k)
+   // for k ranks. Already-sorted input is detected and read directly.
+
+   // index of the p-th quantile in sorted order (same rule as before:
+   // floor(p * n), clamped to the last element)
+   static size_t quantile_rank(size_t n, double p){
+        assert(n > 0 && p >= 0.0 && p <= 1.0);
+        return std::min(n - 1, static_cast<size_t>(p * n));
+   }
+
+   // place the elements of the given sorted ranks (ranks[first, last)) at
+   // their sorted positions, looking only at data[lo, hi)
+   static void select_ranks(double* data, size_t lo, size_t hi,
+                            const size_t* first, const size_t* last){
+        if (first == last) return;
+        const size_t* mid = first + (last - first) / 2;
+        std::nth_element(data + lo, data + *mid, data + hi);
+        select_ranks(data, lo, *mid, first, mid);
+        const size_t* right = std::upper_bound(mid, last, *mid);
+        select_ranks(data, *mid + 1, hi, right, last);
+   }
+
+   // values at the given ranks (any order, duplicates allowed)
+   static Vector values_at_ranks(ConstVectorSpan v, const std::vector<size_t>& ranks){
+        Vector result(ranks.size());
+        if (std::is_sorted(v.begin(), v.end())){
+            for (size_t i = 0; i < ranks.size(); i++)
+                result[i] = v[ranks[i]];
+            return result;
+        }
+
+        std::vector<size_t> sorted_ranks = ranks;
+        std::sort(sorted_ranks.begin(), sorted_ranks.end());
+        ScratchScope scratch;
+        ScratchVector work(v.begin(), v.end(), &scratch.arena());
+        select_ranks(work.data(), 0, work.size(),
+                     sorted_ranks.data(), sorted_ranks.data() + sorted_ranks.size());
+        for (size_t i = 0; i < ranks.size(); i++)
+            result[i] = work[ranks[i]];
+        return result;
+   }
+
    double median(const Vector& v){
-         std::vector<double> sorted_v = v; 
-         std::sort(sorted_v.begin(), sorted_v.end());
-         size_t n = sorted_v.size();
+         return median(ConstVectorSpan(v));
+   }
+
+   double median(ConstVectorSpan v){
+         size_t n = v.size();
+         assert(n > 0);
          if (n % 2 == 1) { // odd number of elements 
-            return sorted_v[n / 2];
+            return values_at_ranks(v, {n / 2})[0];
          } else {
-              return (sorted_v[n / 2 - 1] + sorted_v[n / 2]) / 2.0;
+              Vector middle = values_at_ranks(v, {n / 2 - 1, n / 2});
+              return (middle[0] + middle[1]) / 2.0;
          }
    }
 
     double quantile(const Vector& v,double p){
-        int p_index = (int)(p * v.size());
-        Vector sorted_v = v;  // doing this because i dont want to modify the original v 
-        std::sort(sorted_v.begin(),sorted_v.end());
-        return sorted_v[p_index];
+        return quantile(ConstVectorSpan(v), p);
+    }
+
+    double quantile(ConstVectorSpan v, double p){
+        return values_at_ranks(v, {quantile_rank(v.size(), p)})[0];
+    }
 
+    Vector quantiles(const Vector& v, const Vector& ps){
+        return quantiles(ConstVectorSpan(v), ps);
+    }
+
+    Vector quantiles(ConstVectorSpan v, const Vector& ps){
+        std::vector<size_t> ranks(ps.size());
+        for (size_t i = 0; i < ps.size(); i++)
+            ranks[i] = quantile_rank(v.size(), ps[i]);
+        return values_at_ranks(v, ranks);
+    }
+
+    double quantile_sorted(const Vector& sorted_v, double p){
+        assert(std::is_sorted(sorted_v.begin(), sorted_v.end()));
+        return sorted_v[quantile_rank(sorted_v.size(), p)];
+    }
+
+    Vector quantiles_sorted(const Vector& sorted_v, const Vector& ps){
+        assert(std::is_sorted(sorted_v.begin(), sorted_v.end()));
+        Vector result(ps.size());
+        for (size_t i = 0; i < ps.size(); i++)
+            result[i] = sorted_v[quantile_rank(sorted_v.size(), ps[i])];
+        return result;
     }
     
-   Vector mode(const Vector& x) {
-        if (x.empty()) return {};
-        std::unordered_map<double, int> counts; // key(double),value(int)
-        for (double val : x) {
-            counts[val]++;
+   // ---------------- mode ----------------
+   // Small inputs are sorted (arena scratch copy) and counted in runs;
+   // larger ones are counted in an open-addressing table that grows with
+   // the number of distinct values, so there is no allocation per value.
+   // Modes come back in ascending order.
+
+   static constexpr size_t kSortModeMax = 4096;
+
+   static Vector mode_by_sorting(ConstVectorSpan x){
+        ScratchScope scratch;
+        ScratchVector sorted(x.begin(), x.end(), &scratch.arena());
+        std::sort(sorted.begin(), sorted.end());
+
+        Vector modes;
+        size_t max_count = 0;
+        for (size_t lo = 0, hi; lo < sorted.size(); lo = hi){
+            hi = lo + 1;
+            while (hi < sorted.size() && sorted[hi] == sorted[lo]) hi++;
+            if (hi - lo > max_count){
+                max_count = hi - lo;
+                modes.clear();
+            }
+            if (hi - lo == max_count) modes.push_back(sorted[lo]);
         }
-        int max_count = 0;
-        for (const auto& pair : counts) { // pair {key,value}
-            if (pair.second > max_count) {
-                max_count = pair.second;
+        return modes;
+   }
+
+   static Vector mode_by_hashing(ConstVectorSpan x){
+        struct Slot { uint64_t key; size_t count; };   // count == 0: empty
+        std::vector<Slot> table(1024, Slot{0, 0});
+        size_t used = 0;
+
+        auto insert = [](std::vector<Slot>& t, uint64_t key, size_t count){
+            const size_t mask = t.size() - 1;
+            size_t i = detail::hash_key(key) & mask;
+            while (t[i].count != 0 && t[i].key != key) i = (i + 1) & mask;
+            const bool fresh = t[i].count == 0;
+            t[i].key = key;
+            t[i].count += count;
+            return fresh;
+        };
+
+        for (double val : x){
+            if (2 * (used + 1) > table.size()){   // keep the load factor <= 1/2
+                std::vector<Slot> bigger(2 * table.size(), Slot{0, 0});
+                for (const Slot& slot : table)
+                    if (slot.count != 0) insert(bigger, slot.key, slot.count);
+                table.swap(bigger);
             }
+            if (insert(table, detail::value_key(val), 1)) used++;
         }
+
+        size_t max_count = 0;
+        for (const Slot& slot : table) max_count = std::max(max_count, slot.count);
         Vector modes;
-        for (const auto& pair : counts) {
-            if (pair.second == max_count) {
-                modes.push_back(pair.first);
+        for (const Slot& slot : table){
+            if (slot.count == max_count){
+                double value;
+                std::memcpy(&value, &slot.key, sizeof value);
+                modes.push_back(value);
             }
-    }
+        }
+        std::sort(modes.begin(), modes.end());
+        return modes;
+   }
+
+   Vector mode(const Vector& x) {
+        if (x.empty()) return {};
+        const size_t nans = std::count_if(x.begin(), x.end(), [](double v){ return std::isnan(v); });
+        if (nans == 0)
+            return x.size() <= kSortModeMax ? mode_by_sorting(x) : mode_by_hashing(x);
+
+        // NaN != NaN, so every NaN is a distinct value seen once: NaNs are
+        // kept out of the sort and the table, and only join the modes when
+        // no value occurs more than once
+        ScratchScope scratch;
+        ScratchVector rest(&scratch.arena());
+        rest.reserve(x.size() - nans);
+        for (double v : x)
+            if (!std::isnan(v)) rest.push_back(v);
+
+        Vector modes;
+        if (!rest.empty())
+            modes = rest.size() <= kSortModeMax ? mode_by_sorting(rest) : mode_by_hashing(rest);
+        if (modes.size() == rest.size())   // all distinct
+            modes.insert(modes.end(), nans, std::numeric_limits<double>::quiet_NaN());
+        return modes;
+   }
 
-    return modes;
-    
-}
     double data_range(const Vector& v){
+            return data_range(ConstVectorSpan(v));
+    }
+
+    double data_range(ConstVectorSpan v){
             auto [min_val,max_val] = std::minmax_element(v.begin(),v.end()); 
             double i_min = *min_val; 
             double i_max = *max_val; 
@@ -73,38 +227,300 @@ namespace ds {
         
     } 
 
+    // variance, covariance and correlation make one pass over the data
+    // with the streaming accumulators (ds/accumulators.hpp) and allocate
+    // nothing
     double variance(const Vector& xs){
+        return variance(ConstVectorSpan(xs));
+    }
+    double variance(ConstVectorSpan xs){
         assert(xs.size() >= 2); 
-        auto n = xs.size();
-        Vector deviations = de_mean(xs);
-        double result =  sum_of_squares(deviations); 
-        return result / (n -1); 
+        RunningStats stats;
+        stats.push(xs);
+        return stats.variance();
 
     }
     double standard_deviation(const Vector& xs){
        return std::sqrt(variance(xs));
 
     }
+    double standard_deviation(ConstVectorSpan xs){
+       return std::sqrt(variance(xs));
+    }
     double interquartile_range(const Vector& xs){
-        return quantile(xs,0.75) - quantile(xs,0.25);
+        return interquartile_range(ConstVectorSpan(xs));
+    }
+    double interquartile_range(ConstVectorSpan xs){
+        Vector q = quantiles(xs, {0.25, 0.75});   // one copy, shared partitioning
+        return q[1] - q[0];
     }
     
     double covariance(const Vector& xs, const Vector& ys){
-        assert(xs.size() == ys.size());
-        return dot(de_mean(xs),de_mean(ys)) / (xs.size() -1);
+        return covariance(ConstVectorSpan(xs), ConstVectorSpan(ys));
+    }
+
+    double covariance(ConstVectorSpan xs, ConstVectorSpan ys){
+        assert(xs.size() == ys.size() && xs.size() >= 2);
+        RunningCovariance acc;
+        acc.push(xs, ys);
+        return acc.covariance();
 
     }
 
     double correlation(const Vector& xs,const Vector& ys){
+       return correlation(ConstVectorSpan(xs), ConstVectorSpan(ys));
+    }
+
+    double correlation(ConstVectorSpan xs, ConstVectorSpan ys){
+       assert(xs.size() == ys.size());
+       RunningCovariance acc;
+       acc.push(xs, ys);
+       return acc.correlation();   // 0 if either side is constant
+
+    }
+
+    // ---------------- parallel reductions ----------------
+    // The data is cut into chunk_count() contiguous chunks, each chunk is
+    // summarized on the pool, and the partials are combined in chunk order
+    // (sums added, moments merged with RunningStats / RunningCovariance).
+    // The chunking depends only on the size and num_threads(), so a fixed
+    // thread count gives bit-identical results run to run.
+
+    static constexpr size_t kMinParallelChunk = size_t(1) << 15;
+
+    // one partial per chunk, in chunk order
+    template<typename Partial, typename F>
+    static std::vector<Partial> chunk_partials(size_t n, F&& summarize){
+        const size_t chunks = chunk_count(n, kMinParallelChunk);
+        std::vector<Partial> partials(chunks);
+        parallel_for_chunks(chunks, [&](size_t c){
+            const auto range = chunk_range(n, chunks, c);
+            partials[c] = summarize(range.first, range.second);
+        });
+        return partials;
+    }
+
+    static RunningStats parallel_stats(const Vector& xs){
+        const ConstVectorSpan all(xs);
+        RunningStats total;
+        for (const RunningStats& part : chunk_partials<RunningStats>(xs.size(), [&](size_t lo, size_t hi){
+                 RunningStats stats;
+                 stats.push(all.subspan(lo, hi - lo));
+                 return stats;
+             }))
+            total.merge(part);
+        return total;
+    }
+
+    static RunningCovariance parallel_covariance(const Vector& xs, const Vector& ys){
+        assert(xs.size() == ys.size());
+        const ConstVectorSpan x(xs), y(ys);
+        RunningCovariance total;
+        for (const RunningCovariance& part : chunk_partials<RunningCovariance>(xs.size(), [&](size_t lo, size_t hi){
+                 RunningCovariance acc;
+                 acc.push(x.subspan(lo, hi - lo), y.subspan(lo, hi - lo));
+                 return acc;
+             }))
+            total.merge(part);
+        return total;
+    }
+
+    double mean(execution::parallel_policy, const Vector& v){
+        assert(!v.empty());
+        // block means merged with Chan's update, like variance(par)
+        return parallel_stats(v).mean();
+    }
+
+    double variance(execution::parallel_policy, const Vector& xs){
+        assert(xs.size() >= 2);
+        return parallel_stats(xs).variance();
+    }
+
+    double standard_deviation(execution::parallel_policy, const Vector& xs){
+        return std::sqrt(variance(execution::par, xs));
+    }
+
+    double data_range(execution::parallel_policy, const Vector& v){
+        assert(!v.empty());
+        double lo_val = v[0], hi_val = v[0];
+        for (const auto& part : chunk_partials<std::pair<double, double>>(v.size(), [&](size_t lo, size_t hi){
+                 auto [min_it, max_it] = std::minmax_element(v.begin() + lo, v.begin() + hi);
+                 return std::make_pair(*min_it, *max_it);
+             })){
+            lo_val = std::min(lo_val, part.first);
+            hi_val = std::max(hi_val, part.second);
+        }
+        return hi_val - lo_val;
+    }
+
+    Vector de_mean(execution::parallel_policy, const Vector& xs){
+        const double x_bar = mean(execution::par, xs);
+        Vector result(xs.size());
+        parallel_for(0, xs.size(), kMinParallelChunk, [&](size_t lo, size_t hi){
+            for (size_t i = lo; i < hi; i++)
+                result[i] = xs[i] - x_bar;
+        });
+        return result;
+    }
+
+    double covariance(execution::parallel_policy, const Vector& xs, const Vector& ys){
+        assert(xs.size() >= 2);
+        return parallel_covariance(xs, ys).covariance();
+    }
+
+    double correlation(execution::parallel_policy, const Vector& xs, const Vector& ys){
+        return parallel_covariance(xs, ys).correlation();
+    }
+
+    // ---------------- covariance / correlation matrices ----------------
+    // Every column is centered (and, for correlation, scaled to unit
+    // norm) once into Z, k x n; then all pairs are Z Z^T. Only the lower
+    // triangle is computed, one GEMM per block row, and mirrored.
+
+    static constexpr size_t kPairBlock = 256;   // block rows of the symmetric product
+
+    static DenseMatrix gram_of_scaled_columns(ConstMatrixView X, bool unit_norm){
+        const size_t n = X.rows(), k = X.cols();
+        assert(n >= 2);
+
+        Vector sums(k, 0.0);
+        for (size_t i = 0; i < n; i++)
+            axpy(1.0, X.row(i), sums);
+
+        DenseMatrix Z(k, n);
+        transpose(X, Z);
+        parallel_for(0, k, 16, [&](size_t lo, size_t hi){
+            for (size_t c = lo; c < hi; c++){
+                VectorSpan z = Z.row(c);
+                const double mu = sums[c] / n;
+                for (double& v : z) v -= mu;
+                double scale = 1.0 / std::sqrt(double(n - 1));
+                if (unit_norm){
+                    const double norm2 = sum_of_squares(ConstVectorSpan(z));
+                    scale = norm2 > 0 ? 1.0 / std::sqrt(norm2) : 0.0;   // constant: 0
+                }
+                scal(scale, z);
+            }
+        });
+        const DenseMatrix Zt = transpose(Z);
+
+        DenseMatrix C(k, k);
+        for (size_t i0 = 0; i0 < k; i0 += kPairBlock){
+            const size_t bi = std::min(kPairBlock, k - i0);
+            gemm(1.0, Z.block(i0, 0, bi, n), Zt.block(0, 0, n, i0 + bi),
+                 0.0, C.block(i0, 0, bi, i0 + bi));
+        }
+        for (size_t i = 0; i < k; i++)
+            for (size_t j = i + 1; j < k; j++)
+                C(i, j) = C(j, i);
+        return C;
+    }
+
+    DenseMatrix covariance_matrix(ConstMatrixView X){
+        return gram_of_scaled_columns(X, false);
+    }
+
+    DenseMatrix correlation_matrix(ConstMatrixView X){
+        DenseMatrix R = gram_of_scaled_columns(X, true);
+        for (size_t i = 0; i < R.rows(); i++)
+            if (R(i, i) != 0.0) R(i, i) = 1.0;   // exact, not 1 +- rounding
+        return R;
+    }
+
+    // ---------------- float data ----------------
+    // Two passes (mean, then centered sums) on kernels that widen each
+    // float to double, so nothing is rounded to float along the way.
+
+    double mean(ConstFloatSpan v){
+        assert(!v.empty());
+        return simd::kernels().f32.sum(v.data(), v.size()) / v.size();
+    }
+
+    double variance(ConstFloatSpan xs){
+        assert(xs.size() >= 2);
+        double x_bar = mean(xs);
+        double result = simd::kernels().f32.centered_dot(xs.data(), xs.data(), x_bar, x_bar, xs.size());
+        return result / (xs.size() - 1);
+    }
+
+    double standard_deviation(ConstFloatSpan xs){
+        return std::sqrt(variance(xs));
+    }
+
+    double covariance(ConstFloatSpan xs, ConstFloatSpan ys){
+        assert(xs.size() == ys.size() && xs.size() >= 2);
+        double result = simd::kernels().f32.centered_dot(xs.data(), ys.data(), mean(xs), mean(ys), xs.size());
+        return result / (xs.size() - 1);
+    }
+
+    double correlation(ConstFloatSpan xs, ConstFloatSpan ys){
        auto stdev_x = standard_deviation(xs);
-       auto stdev_y = standard_deviation(ys); 
+       auto stdev_y = standard_deviation(ys);
        if(stdev_x > 0 && stdev_y > 0){
-        return covariance(xs,ys) / stdev_x / stdev_y; 
+        return covariance(xs,ys) / stdev_x / stdev_y;
        } else{
         return 0;
        }
+    }
+
+    // ---------------- sparse data ----------------
 
+    double mean(SparseView x){
+        assert(x.dim > 0);
+        double sum = 0.0;
+        for (double v : x.values)
+            sum += v;
+        return sum / x.dim;
     }
 
+    double variance(SparseView x){
+        assert(x.dim >= 2);
+        double x_bar = mean(x);
+        // stored entries deviate by (v - x_bar), every implicit zero by -x_bar
+        double result = (x.dim - x.nnz()) * x_bar * x_bar;
+        for (double v : x.values)
+            result += (v - x_bar) * (v - x_bar);
+        return result / (x.dim - 1);
+    }
 
-}
\ No newline at end of file
+    double standard_deviation(SparseView x){
+        return std::sqrt(variance(x));
+    }
+
+    double covariance(SparseView xs, SparseView ys){
+        assert(xs.dim == ys.dim && xs.dim >= 2);
+        double x_bar = mean(xs);
+        double y_bar = mean(ys);
+
+        // walk the union of both patterns; positions where both are zero
+        // all contribute x_bar * y_bar
+        double result = 0.0;
+        size_t i = 0, j = 0, both_zero = xs.dim;
+        while (i < xs.nnz() || j < ys.nnz()){
+            double x = 0.0, y = 0.0;
+            if (j == ys.nnz() || (i < xs.nnz() && xs.indices[i] < ys.indices[j])){
+                x = xs.values[i++];
+            } else if (i == xs.nnz() || ys.indices[j] < xs.indices[i]){
+                y = ys.values[j++];
+            } else {
+                x = xs.values[i++];
+                y = ys.values[j++];
+            }
+            result += (x - x_bar) * (y - y_bar);
+            --both_zero;
+        }
+        result += both_zero * x_bar * y_bar;
+        return result / (xs.dim - 1);
+    }
+
+    double correlation(SparseView xs, SparseView ys){
+       auto stdev_x = standard_deviation(xs);
+       auto stdev_y = standard_deviation(ys);
+       if(stdev_x > 0 && stdev_y > 0){
+        return covariance(xs,ys) / stdev_x / stdev_y;
+       } else{
+        return 0;
+       }
+    }
+
+}
@@ -1,7 +1,19 @@
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include "ds/arena.hpp"
 #include "ds/linear_algebra.hpp"
+#include "ds/gradient.hpp"
+#include "ds/distances.hpp"
+#include "ds/least_squares.hpp"
+#include "ds/parallel.hpp"
+#include "ds/simd.hpp"
+#include "ds/sparse.hpp"
 
 using namespace ds;
 
@@ -85,6 +97,34 @@ void test_vector_mean() {
     std::cout << "✓ vector_mean passed\n";
 }
 
+void test_vector_sum_compensated() {
+    std::cout << "\n--- Testing vector_sum accuracy and reproducibility ---\n";
+    // 0.1 is not representable; a naive running sum drifts by ~1e-6 here
+    std::vector<Vector> tenths(1000000, Vector{0.1, -0.1});
+    const size_t original = num_threads();
+
+    set_num_threads(4);
+    Vector sum = vector_sum(tenths);
+    assert(std::abs(sum[0] - 100000.0) < 1e-9 && std::abs(sum[1] + 100000.0) < 1e-9 && "vector_sum not compensated");
+    Vector again = vector_sum(tenths);
+    assert(sum == again && "vector_sum not reproducible for a fixed thread count");
+
+    // Infinities survive compensation, within a chunk and across chunks
+    const double inf = std::numeric_limits<double>::infinity();
+    Vector with_inf = vector_sum({{inf, 1.0}, {1.0, -inf}});
+    assert(with_inf[0] == inf && with_inf[1] == -inf && "vector_sum turned inf into NaN");
+    tenths[tenths.size() / 2] = Vector{inf, 0.1};
+    with_inf = vector_sum(tenths);
+    assert(with_inf[0] == inf && std::abs(with_inf[1] + 99999.8) < 1e-9 && "chunked vector_sum lost inf");
+
+    DenseMatrix rows = to_dense(Matrix{{1, 2}, {3, 4}, {5, 6}});
+    assert(vectors_equal(vector_sum(rows), {9, 12}) && "vector_sum(rows) failed");
+    assert(vectors_equal(vector_mean(rows), {3, 4}) && "vector_mean(rows) failed");
+
+    set_num_threads(original);
+    std::cout << "✓ vector_sum is compensated and reproducible\n";
+}
+
 void test_dot_product() {
     std::cout << "\n--- Testing dot product ---\n";
     Vector v{1.0, 2.0, 3.0};
@@ -192,6 +232,639 @@ void test_make_matrix() {
     std::cout << "✓ make_matrix passed\n";
 }
 
+// ============== Dense Matrix Tests ==============
+
+void test_dense_matrix_layout() {
+    std::cout << "\n--- Testing DenseMatrix layout ---\n";
+    DenseMatrix A = make_dense_matrix(3, 4, [](int i, int j) { return 10 * i + j; });
+    auto [rows, cols] = shape(A);
+    assert(rows == 3 && cols == 4 && "dense shape failed");
+    assert(A.stride() == 4 && "dense stride should equal cols");
+    assert(reinterpret_cast<uintptr_t>(A.data()) % kDefaultAlignment == 0 && "dense buffer not aligned");
+    // Row-major and contiguous: entry (i, j) lives at data()[i * cols + j]
+    assert(approx_equal(A.data()[2 * 4 + 3], 23) && "dense storage is not row-major");
+    std::cout << "✓ DenseMatrix layout passed\n";
+}
+
+void test_dense_row_column_views() {
+    std::cout << "\n--- Testing DenseMatrix row/column views ---\n";
+    DenseMatrix A = to_dense(Matrix{{1, 2, 3}, {4, 5, 6}});
+    ConstVectorSpan row = get_row(A, 1);
+    ConstStridedSpan col = get_column(A, 1);
+    assert(row.size() == 3 && approx_equal(row[0], 4) && approx_equal(row[2], 6) && "dense get_row failed");
+    assert(col.size() == 2 && approx_equal(col[0], 2) && approx_equal(col[1], 5) && "dense get_column failed");
+
+    // Views alias the matrix storage
+    A.row(0)[1] = 42;
+    assert(approx_equal(col[0], 42) && "column view does not alias storage");
+    std::cout << "✓ DenseMatrix row/column views passed\n";
+}
+
+void test_dense_block_view() {
+    std::cout << "\n--- Testing DenseMatrix block view ---\n";
+    DenseMatrix A = make_dense_matrix(4, 4, [](int i, int j) { return 4 * i + j; });
+    MatrixView B = A.block(1, 2, 2, 2);
+    assert(B.rows() == 2 && B.cols() == 2 && B.stride() == 4 && "block shape failed");
+    assert(approx_equal(B(0, 0), 6) && approx_equal(B(1, 1), 11) && "block entries wrong");
+    assert(approx_equal(B.column(1)[1], 11) && "block column view wrong");
+    B(1, 0) = -1;
+    assert(approx_equal(A(2, 2), -1) && "block view does not alias storage");
+    std::cout << "✓ DenseMatrix block view passed\n";
+}
+
+void test_dense_identity_and_conversion() {
+    std::cout << "\n--- Testing dense_identity_matrix / to_nested ---\n";
+    Matrix I = to_nested(dense_identity_matrix(3));
+    Matrix expected = identity_matrix(3);
+    assert(I.size() == expected.size() && "to_nested rows wrong");
+    for (size_t i = 0; i < I.size(); ++i)
+        assert(vectors_equal(I[i], expected[i]) && "dense identity differs from identity_matrix");
+    std::cout << "✓ dense_identity_matrix / to_nested passed\n";
+}
+
+void test_inplace_ops() {
+    std::cout << "\n--- Testing in-place vector operations ---\n";
+    Vector v{1.0, 2.0, 3.0};
+    Vector w{4.0, 5.0, 6.0};
+    Vector out(3);
+
+    add_into(out, v, w);
+    assert(vectors_equal(out, {5.0, 7.0, 9.0}) && "add_into failed");
+    subtract_into(out, out, v);   // out may alias an input
+    assert(vectors_equal(out, w) && "subtract_into failed");
+    scale_into(out, 0.5, v);
+    assert(vectors_equal(out, {0.5, 1.0, 1.5}) && "scale_into failed");
+
+    Vector y = w;
+    axpy(2.0, v, y);
+    assert(vectors_equal(y, {6.0, 9.0, 12.0}) && "axpy failed");
+    scal(-1.0, y);
+    assert(vectors_equal(y, {-6.0, -9.0, -12.0}) && "scal failed");
+    accumulate(y, w);
+    assert(vectors_equal(y, {-2.0, -4.0, -6.0}) && "accumulate failed");
+
+    // Spans can address part of caller-owned memory, e.g. a matrix row
+    DenseMatrix M(2, 3);
+    accumulate(M.row(1), v);
+    assert(approx_equal(M(1, 2), 3.0) && approx_equal(M(0, 2), 0.0) && "accumulate into row failed");
+    std::cout << "✓ in-place vector operations passed\n";
+}
+
+// ============== Vector Expression Tests ==============
+
+void test_vector_expressions() {
+    std::cout << "\n--- Testing lazy vector expressions ---\n";
+    Vector v{1.0, 2.0, 3.0};
+    Vector g{0.5, -1.0, 2.0};
+
+    Vector step = v + -0.1 * g;
+    assert(vectors_equal(step, {0.95, 2.1, 2.8}) && "v + c * g failed");
+
+    Vector mixed = 2.0 * (v - g) / 4.0 + hadamard(v, g);
+    assert(vectors_equal(mixed, {0.75, -0.5, 6.5}) && "compound expression failed");
+
+    assert(approx_equal(sum_of_squares(v - g), 0.25 + 9.0 + 1.0) && "sum_of_squares(v - w) failed");
+    assert(approx_equal(dot(v + g, v), dot(v, v) + dot(g, v)) && "dot(expr, v) failed");
+    assert(approx_equal(magnitude(Vector{3.0, 0.0} - Vector{0.0, 4.0}), 5.0) && "magnitude(expr) failed");
+
+    // In-place update through an expression that reads its own target
+    assign(v, v + -0.1 * g);
+    assert(vectors_equal(v, step) && "assign with aliasing failed");
+    std::cout << "✓ lazy vector expressions passed\n";
+}
+
+// ============== SIMD Dispatch Tests ==============
+
+void test_simd_levels_agree() {
+    std::cout << "\n--- Testing SIMD kernels at every dispatch level ---\n";
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    const SimdLevel original = simd_level();
+    const double u = std::ldexp(1.0, -53);
+
+    // Lengths straddle every unroll width and tail size
+    for (size_t n : {0, 1, 2, 3, 7, 8, 15, 16, 31, 33, 64, 67, 1000}) {
+        Vector v(n), w(n);
+        for (size_t i = 0; i < n; ++i) { v[i] = dist(gen); w[i] = dist(gen); }
+
+        long double exact_dot = 0, exact_sq = 0, abs_dot = 0, abs_sq = 0;
+        for (size_t i = 0; i < n; ++i) {
+            exact_dot += (long double)v[i] * w[i];
+            abs_dot += std::abs((long double)v[i] * w[i]);
+            long double d = (long double)v[i] - w[i];
+            exact_sq += d * d;
+            abs_sq += d * d;
+        }
+
+        set_simd_level(SimdLevel::Scalar);
+        const Vector ref_add = add(v, w);
+        const Vector ref_sub = subtract(v, w);
+        const Vector ref_scale = scalar_multiply(0.37, v);
+        Vector ref_axpy = w;
+        axpy(-1.3, v, ref_axpy);
+
+        for (int l = 0; l <= static_cast<int>(detected_simd_level()); ++l) {
+            set_simd_level(static_cast<SimdLevel>(l));
+            // Accuracy contract from ds/simd.hpp with K <= 32
+            const double bound = (n / 4.0 + 5 + 2) * u;
+            assert(std::abs(dot(v, w) - (double)exact_dot) <= bound * abs_dot + 1e-300 && "dot outside error bound");
+            assert(std::abs(squared_distance(v, w) - (double)exact_sq) <= bound * abs_sq + 1e-300 && "squared_distance outside error bound");
+            // Elementwise kernels are bitwise identical across levels
+            assert(add(v, w) == ref_add && "add differs between levels");
+            assert(subtract(v, w) == ref_sub && "subtract differs between levels");
+            assert(scalar_multiply(0.37, v) == ref_scale && "scalar_multiply differs between levels");
+            Vector y = w;
+            axpy(-1.3, v, y);
+            assert(y == ref_axpy && "axpy differs between levels");
+        }
+    }
+
+    set_simd_level(original);
+    std::cout << "✓ SIMD kernels agree up to " << simd_level_name(detected_simd_level()) << "\n";
+}
+
+void test_float_kernels() {
+    std::cout << "\n--- Testing float kernels at every dispatch level ---\n";
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    const SimdLevel original = simd_level();
+    const double u = std::ldexp(1.0, -53);
+
+    for (size_t n : {0, 1, 3, 4, 15, 16, 17, 31, 32, 33, 100, 1001}) {
+        FloatVector v(n), w(n);
+        for (size_t i = 0; i < n; ++i) { v[i] = dist(gen); w[i] = dist(gen); }
+
+        // Mixed precision: same answer (within the double bound) as widening first
+        const Vector dv = to_double(v), dw = to_double(w);
+        long double exact_dot = 0, abs_dot = 0;
+        for (size_t i = 0; i < n; ++i) {
+            exact_dot += (long double)dv[i] * dw[i];
+            abs_dot += std::abs((long double)dv[i] * dw[i]);
+        }
+
+        set_simd_level(SimdLevel::Scalar);
+        const FloatVector ref_add = add(v, w);
+        const FloatVector ref_scale = scalar_multiply(0.37f, v);
+        FloatVector ref_axpy = w;
+        axpy(-1.3f, v, ref_axpy);
+
+        for (int l = 0; l <= static_cast<int>(detected_simd_level()); ++l) {
+            set_simd_level(static_cast<SimdLevel>(l));
+            const double bound = (n / 4.0 + 5 + 2) * u;
+            assert(std::abs(dot(v, w) - (double)exact_dot) <= bound * abs_dot + 1e-300 && "float dot outside error bound");
+            assert(approx_equal(squared_distance(v, w), squared_distance(dv, dw), 1e-12) && "float squared_distance differs");
+            assert(add(v, w) == ref_add && "float add differs between levels");
+            assert(scalar_multiply(0.37f, v) == ref_scale && "float scalar_multiply differs between levels");
+            FloatVector y = w;
+            axpy(-1.3f, v, y);
+            assert(y == ref_axpy && "float axpy differs between levels");
+        }
+    }
+
+    set_simd_level(original);
+    std::cout << "✓ float kernels agree up to " << simd_level_name(detected_simd_level()) << "\n";
+}
+
+// ============== Thread Pool Tests ==============
+
+void test_parallel_for() {
+    std::cout << "\n--- Testing parallel_for ---\n";
+    const size_t original = num_threads();
+    set_num_threads(4);
+
+    std::vector<int> hits(1000, 0);
+    parallel_for(0, hits.size(), 10, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) hits[i]++;
+    });
+    assert(std::all_of(hits.begin(), hits.end(), [](int h) { return h == 1; }) && "parallel_for missed or repeated indices");
+
+    bool caught = false;
+    try {
+        parallel_for_chunks(8, [](size_t c) {
+            if (c == 5) throw std::runtime_error("chunk failed");
+        });
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    assert(caught && "parallel_for_chunks did not rethrow task exception");
+
+    set_num_threads(original);
+    std::cout << "✓ parallel_for passed\n";
+}
+
+// ============== Matrix Product Tests ==============
+
+DenseMatrix random_matrix(size_t rows, size_t cols, std::mt19937& gen) {
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    DenseMatrix M(rows, cols);
+    for (size_t i = 0; i < M.size(); ++i) M.data()[i] = dist(gen);
+    return M;
+}
+
+DenseMatrix naive_multiply(const DenseMatrix& A, const DenseMatrix& B) {
+    DenseMatrix C(A.rows(), B.cols());
+    for (size_t i = 0; i < A.rows(); ++i)
+        for (size_t j = 0; j < B.cols(); ++j)
+            for (size_t k = 0; k < A.cols(); ++k)
+                C(i, j) += A(i, k) * B(k, j);
+    return C;
+}
+
+bool matrices_equal(const DenseMatrix& A, const DenseMatrix& B, double epsilon = 1e-9) {
+    if (A.rows() != B.rows() || A.cols() != B.cols()) return false;
+    for (size_t i = 0; i < A.size(); ++i)
+        if (!approx_equal(A.data()[i], B.data()[i], epsilon)) return false;
+    return true;
+}
+
+void test_matrix_multiply() {
+    std::cout << "\n--- Testing matrix_multiply / gemm ---\n";
+    std::mt19937 gen(7);
+    const SimdLevel original = simd_level();
+
+    // Shapes cover partial register tiles, several row blocks and k > KC
+    const size_t shapes[][3] = {{1, 1, 1}, {5, 3, 7}, {13, 17, 11}, {100, 300, 37}, {197, 64, 260}};
+    for (int l = 0; l <= static_cast<int>(detected_simd_level()); ++l) {
+        set_simd_level(static_cast<SimdLevel>(l));
+        for (const auto& s : shapes) {
+            DenseMatrix A = random_matrix(s[0], s[1], gen);
+            DenseMatrix B = random_matrix(s[1], s[2], gen);
+            assert(matrices_equal(matrix_multiply(A, B), naive_multiply(A, B)) && "matrix_multiply failed");
+        }
+    }
+    set_simd_level(original);
+
+    // C = alpha*A*B + beta*C
+    DenseMatrix A = random_matrix(9, 4, gen), B = random_matrix(4, 10, gen), C = random_matrix(9, 10, gen);
+    DenseMatrix expected = naive_multiply(A, B);
+    for (size_t i = 0; i < C.size(); ++i)
+        expected.data()[i] = 2.0 * expected.data()[i] + 0.5 * C.data()[i];
+    gemm(2.0, A, B, 0.5, C);
+    assert(matrices_equal(C, expected) && "gemm alpha/beta failed");
+
+    // Nested storage overload
+    Matrix P = matrix_multiply(Matrix{{1, 2}, {3, 4}}, Matrix{{5, 6}, {7, 8}});
+    assert(vectors_equal(P[0], {19, 22}) && vectors_equal(P[1], {43, 50}) && "nested matrix_multiply failed");
+    std::cout << "✓ matrix_multiply / gemm passed\n";
+}
+
+void test_matrix_multiply_threads() {
+    std::cout << "\n--- Testing matrix_multiply thread independence ---\n";
+    std::mt19937 gen(11);
+    DenseMatrix A = random_matrix(300, 70, gen), B = random_matrix(70, 50, gen);
+    const size_t original = num_threads();
+
+    set_num_threads(1);
+    DenseMatrix serial = matrix_multiply(A, B);
+    set_num_threads(4);
+    DenseMatrix threaded = matrix_multiply(A, B);
+    set_num_threads(original);
+
+    // Same accumulation order per entry: bitwise identical
+    for (size_t i = 0; i < serial.size(); ++i)
+        assert(serial.data()[i] == threaded.data()[i] && "threaded gemm differs from serial");
+    std::cout << "✓ matrix_multiply is thread-count independent\n";
+}
+
+void test_matvec() {
+    std::cout << "\n--- Testing matvec / gemv ---\n";
+    Matrix A{{1, 2, 3}, {4, 5, 6}};
+    Vector x{1, 0, -1};
+    assert(vectors_equal(matvec(A, x), {-2, -2}) && "nested matvec failed");
+    assert(vectors_equal(matvec(to_dense(A), x), {-2, -2}) && "dense matvec failed");
+
+    Vector y{1, 1};
+    gemv(2.0, to_dense(A), x, 3.0, y);
+    assert(vectors_equal(y, {-1, -1}) && "gemv alpha/beta failed");
+    std::cout << "✓ matvec / gemv passed\n";
+}
+
+void test_transpose() {
+    std::cout << "\n--- Testing transpose ---\n";
+    std::mt19937 gen(3);
+    DenseMatrix A = random_matrix(77, 45, gen);
+    DenseMatrix T = transpose(A);
+    assert(T.rows() == 45 && T.cols() == 77 && "transpose shape wrong");
+    for (size_t i = 0; i < A.rows(); ++i)
+        for (size_t j = 0; j < A.cols(); ++j)
+            assert(T(j, i) == A(i, j) && "transpose entry wrong");
+
+    Matrix N = transpose(Matrix{{1, 2, 3}, {4, 5, 6}});
+    assert(N.size() == 3 && vectors_equal(N[2], {3, 6}) && "nested transpose failed");
+    std::cout << "✓ transpose passed\n";
+}
+
+// ============== Pairwise Distance Tests ==============
+
+void test_pairwise_squared_distances() {
+    std::cout << "\n--- Testing pairwise_squared_distances ---\n";
+    std::mt19937 gen(5);
+    DenseMatrix A = random_matrix(37, 6, gen);
+    DenseMatrix B = random_matrix(53, 6, gen);
+    DenseMatrix D = pairwise_squared_distances(A, B);
+    assert(D.rows() == 37 && D.cols() == 53 && "pairwise shape wrong");
+
+    for (size_t i = 0; i < A.rows(); ++i)
+        for (size_t j = 0; j < B.rows(); ++j) {
+            Vector a(A.row(i).begin(), A.row(i).end());
+            Vector b(B.row(j).begin(), B.row(j).end());
+            assert(approx_equal(D(i, j), squared_distance(a, b), 1e-12) && "pairwise distance wrong");
+        }
+
+    Matrix N = pairwise_squared_distances(Matrix{{0, 0}, {1, 1}}, Matrix{{3, 4}});
+    assert(approx_equal(N[0][0], 25) && approx_equal(N[1][0], 13) && "nested pairwise failed");
+    std::cout << "✓ pairwise_squared_distances passed\n";
+}
+
+void test_pairwise_top_k() {
+    std::cout << "\n--- Testing pairwise_top_k ---\n";
+    std::mt19937 gen(9);
+    // More reference points than one column tile, more queries than one row tile
+    DenseMatrix A = random_matrix(70, 4, gen);
+    DenseMatrix B = random_matrix(2100, 4, gen);
+    const size_t k = 5;
+
+    auto knn = pairwise_top_k(A, B, k);
+    DenseMatrix D = pairwise_squared_distances(A, B);
+    assert(knn.size() == A.rows() && "top_k result count wrong");
+
+    for (size_t i = 0; i < A.rows(); ++i) {
+        std::vector<size_t> order(B.rows());
+        for (size_t j = 0; j < order.size(); ++j) order[j] = j;
+        std::partial_sort(order.begin(), order.begin() + k, order.end(),
+                          [&](size_t a, size_t b) { return D(i, a) < D(i, b); });
+
+        assert(knn[i].size() == k && "top_k list size wrong");
+        for (size_t r = 0; r < k; ++r) {
+            assert(knn[i][r].index == order[r] && "top_k neighbour wrong");
+            assert(approx_equal(knn[i][r].squared_distance, D(i, order[r]), 1e-12) && "top_k distance wrong");
+        }
+    }
+
+    assert(pairwise_top_k(A, B.block(0, 0, 3, 4), 10)[0].size() == 3 && "top_k should clamp k to m");
+
+    // A reference row with NaN is nobody's neighbour, and its distances stay NaN
+    const size_t nan_row = knn[0][0].index;
+    B(nan_row, 2) = std::numeric_limits<double>::quiet_NaN();
+    assert(std::isnan(pairwise_squared_distances(A, B)(0, nan_row)) && "NaN distance clamped to 0");
+    for (const auto& list : pairwise_top_k(A, B, k))
+        for (const Neighbor& nb : list)
+            assert(nb.index != nan_row && "NaN row returned as a neighbour");
+    std::cout << "✓ pairwise_top_k passed\n";
+}
+
+// ============== Arena Tests ==============
+
+void test_arena() {
+    std::cout << "\n--- Testing Arena / ScratchScope ---\n";
+    Arena arena(1024);
+    {
+        std::pmr::vector<double> a(100, 1.0, &arena);
+        std::pmr::vector<double> b(500, 2.0, &arena);   // spills into a second block
+        assert(a[99] == 1.0 && b[499] == 2.0 && "arena vectors corrupted");
+        assert(reinterpret_cast<uintptr_t>(b.data()) % alignof(double) == 0 && "arena misaligned");
+    }
+    const size_t reserved = arena.bytes_reserved();
+    arena.reset();
+    {
+        std::pmr::vector<double> a(100, 1.0, &arena);
+        std::pmr::vector<double> b(500, 2.0, &arena);
+    }
+    assert(arena.bytes_reserved() == reserved && "reset arena should reuse its blocks");
+
+    const Arena::Mark before = scratch_arena().mark();
+    {
+        ScratchScope scope;
+        ScratchVector tmp = make_scratch(64);
+        tmp[63] = 1.0;
+        assert(scratch_arena().mark().offset != before.offset && "scratch allocation did not use the arena");
+    }
+    const Arena::Mark after = scratch_arena().mark();
+    assert(after.block == before.block && after.offset == before.offset && "ScratchScope did not rewind");
+
+    // Span-based kernels accept arena-backed vectors
+    ScratchScope scope;
+    ScratchVector x = make_scratch(3);
+    x[0] = 3.0; x[1] = 4.0;
+    assert(approx_equal(sum_of_squares(x), 25.0) && "sum_of_squares(span) failed");
+    std::cout << "✓ Arena / ScratchScope passed\n";
+}
+
+void test_matrix_generators() {
+    std::cout << "\n--- Testing parallel generators and special matrices ---\n";
+    const size_t original = num_threads();
+    set_num_threads(4);
+
+    auto entry = [](int i, int j) { return 0.5 * i - j; };
+    DenseMatrix serial = make_dense_matrix(300, 70, entry);
+    DenseMatrix parallel = make_dense_matrix(execution::par, 300, 70, entry);
+    assert(to_nested(serial) == to_nested(parallel) && "parallel make_dense_matrix differs");
+    assert(to_nested(serial) == make_matrix(execution::par, 300, 70, entry) && "parallel make_matrix differs");
+
+    // std::function still works through the template
+    std::function<double(int, int)> fn = entry;
+    assert(to_nested(make_dense_matrix(300, 70, fn)) == to_nested(serial) && "std::function generator differs");
+
+    set_num_threads(original);
+
+    Matrix D = diagonal_matrix({1.0, 2.0, 3.0});
+    assert(D[1][1] == 2.0 && D[1][0] == 0.0 && D[2][2] == 3.0 && "diagonal_matrix wrong");
+    assert(to_nested(dense_diagonal_matrix(Vector{1.0, 2.0, 3.0})) == D && "dense_diagonal_matrix wrong");
+    assert(constant_matrix(2, 3, 7.0) == Matrix(2, Vector(3, 7.0)) && "constant_matrix wrong");
+    assert(to_nested(dense_constant_matrix(2, 3, 7.0)) == constant_matrix(2, 3, 7.0) && "dense_constant_matrix wrong");
+    std::cout << "✓ parallel generators and special matrices passed\n";
+}
+
+// ============== Least Squares Tests ==============
+
+void test_cholesky() {
+    std::cout << "\n--- Testing cholesky ---\n";
+    // G = A^T A + I is symmetric positive definite; n > one 64-wide panel
+    std::mt19937 gen(3);
+    DenseMatrix A = random_matrix(200, 150, gen);
+    DenseMatrix G = matrix_multiply(transpose(A), A);
+    for (size_t i = 0; i < G.rows(); ++i) G(i, i) += 1.0;
+
+    DenseMatrix L = G;
+    assert(cholesky(L) && "cholesky rejected an SPD matrix");
+    assert(L(0, 1) == 0.0 && "upper triangle should be zeroed");
+    assert(matrices_equal(matrix_multiply(L, transpose(L)), G, 1e-9) && "L L^T != G");
+
+    DenseMatrix B = random_matrix(150, 4, gen);
+    DenseMatrix X = B;
+    cholesky_solve(L, X);
+    assert(matrices_equal(matrix_multiply(G, X), B, 1e-9) && "cholesky_solve failed");
+
+    DenseMatrix indefinite = dense_diagonal_matrix(Vector{1.0, -1.0, 2.0});
+    assert(!cholesky(indefinite) && "cholesky accepted an indefinite matrix");
+    std::cout << "✓ cholesky passed\n";
+}
+
+void test_least_squares() {
+    std::cout << "\n--- Testing least squares (QR / normal equations) ---\n";
+    std::mt19937 gen(5);
+    DenseMatrix A = random_matrix(300, 100, gen);
+    DenseMatrix B = random_matrix(300, 3, gen);
+
+    DenseMatrix X_qr = least_squares_qr(A, B);
+    DenseMatrix X_ne = least_squares_cholesky(A, B);
+    assert(X_qr.rows() == 100 && X_qr.cols() == 3 && "least squares shape wrong");
+
+    // Optimality: the residual is orthogonal to the columns of A
+    DenseMatrix R = matrix_multiply(A, X_qr);
+    for (size_t i = 0; i < R.rows(); ++i)
+        for (size_t j = 0; j < R.cols(); ++j) R(i, j) -= B(i, j);
+    DenseMatrix AtR = matrix_multiply(transpose(A), R);
+    for (size_t i = 0; i < AtR.size(); ++i)
+        assert(std::abs(AtR.data()[i]) < 1e-9 && "QR residual not orthogonal to A");
+    assert(matrices_equal(X_qr, X_ne, 1e-8) && "QR and normal equations disagree");
+
+    // Single right-hand side and the closed-form simple regression
+    Vector y(B.rows());
+    for (size_t i = 0; i < y.size(); ++i) y[i] = B(i, 0);
+    Vector beta = least_squares(A, y);
+    for (size_t i = 0; i < beta.size(); ++i)
+        assert(approx_equal(beta[i], X_qr(i, 0), 1e-10) && "least_squares differs from column 0");
+
+    Vector xs{0.0, 1.0, 2.0, 3.0, 4.0};
+    Vector ys{2.0, 5.0, 8.0, 11.0, 14.0};   // y = 3x + 2
+    assert(vectors_equal(least_squares_fit(xs, ys), {3.0, 2.0}, 1e-12) && "least_squares_fit failed");
+    std::cout << "✓ least squares passed\n";
+}
+
+// ============== Fixed-Size Vector Tests ==============
+
+void test_fixed_vector() {
+    std::cout << "\n--- Testing FixedVector ---\n";
+    constexpr FixedVector<3> v{{1.0, 2.0, 3.0}};
+    constexpr FixedVector<3> w{{4.0, 5.0, 6.0}};
+
+    // Evaluated entirely at compile time
+    static_assert(dot(v, w) == 32.0, "constexpr dot failed");
+    static_assert(add(v, w) == FixedVector<3>{{5.0, 7.0, 9.0}}, "constexpr add failed");
+    static_assert(squared_distance(v, w) == 27.0, "constexpr squared_distance failed");
+    static_assert(v + 2.0 * w - w == add(v, w), "constexpr operators failed");
+    static_assert(sizeof(FixedVector<3>) == 3 * sizeof(double), "FixedVector should be stored inline");
+
+    assert(approx_equal(magnitude(FixedVector<2>{{3.0, 4.0}}), 5.0) && "FixedVector magnitude failed");
+    assert(approx_equal(distance(v, w), std::sqrt(27.0)) && "FixedVector distance failed");
+
+    // Same answers as the heap-backed API
+    Vector hv{1.0, 2.0, 3.0}, hw{4.0, 5.0, 6.0};
+    FixedVector<3> diff = subtract(v, w);
+    assert(vectors_equal(Vector(diff.begin(), diff.end()), subtract(hv, hw)) && "FixedVector subtract differs");
+
+    // Span conversion plugs into the in-place API
+    FixedVector<3> y = w;
+    axpy(1.0, v, y);
+    assert(y == add(v, w) && "axpy on FixedVector failed");
+    std::cout << "✓ FixedVector passed\n";
+}
+
+void test_fixed_gradient() {
+    std::cout << "\n--- Testing FixedVector gradient helpers ---\n";
+    constexpr FixedVector<2> theta{{2.0, 1.0}};
+    constexpr FixedVector<2> grad = linear_gradient(3.0, 5.0, theta);   // error = 2
+    static_assert(grad == FixedVector<2>{{12.0, 4.0}}, "constexpr linear_gradient failed");
+    static_assert(gradient_step(theta, grad, -0.5) == FixedVector<2>{{-4.0, -1.0}}, "constexpr gradient_step failed");
+
+    Vector heap_grad = linear_gradient(3.0, 5.0, Vector{2.0, 1.0});
+    assert(vectors_equal(heap_grad, {grad[0], grad[1]}) && "fixed and heap linear_gradient differ");
+    std::cout << "✓ FixedVector gradient helpers passed\n";
+}
+
+// ============== Sparse Tests ==============
+
+void test_sparse_vector() {
+    std::cout << "\n--- Testing SparseVector ---\n";
+    Vector dx{0.0, 2.0, 0.0, 0.0, -1.0, 0.0};
+    Vector dy{1.0, 3.0, 0.0, 5.0, 0.0, 0.0};
+    SparseVector x = to_sparse(dx), y = to_sparse(dy);
+    assert(x.nnz() == 2 && y.nnz() == 3 && "to_sparse should drop zeros");
+    assert(vectors_equal(to_dense(x), dx) && "to_dense round trip failed");
+
+    // Unordered construction sorts and sums duplicates
+    SparseVector z(6, {4, 1, 4}, {-3.0, 2.0, 2.0});
+    assert(vectors_equal(to_dense(z), dx) && "SparseVector constructor failed");
+
+    assert(approx_equal(dot(x, dy), dot(dx, dy)) && "sparse-dense dot failed");
+    assert(approx_equal(dot(dx, y), dot(dx, dy)) && "dense-sparse dot failed");
+    assert(approx_equal(dot(x, y), dot(dx, dy)) && "sparse-sparse dot failed");
+    assert(approx_equal(squared_distance(x, y), squared_distance(dx, dy)) && "sparse distance failed");
+    assert(approx_equal(squared_distance(x, dy), squared_distance(dx, dy)) && "mixed distance failed");
+    assert(approx_equal(magnitude(x), magnitude(dx)) && "sparse magnitude failed");
+
+    // Large values sharing an index: nothing may cancel against ||y||^2
+    SparseVector big(2, {0}, {1e8});
+    assert(squared_distance(big, Vector{1e8, 1.0}) == 1.0 && "mixed distance cancels");
+    assert(squared_distance(Vector{1e8, 1.0}, big) == 1.0 && "mixed distance cancels");
+    assert(vectors_equal(to_dense(add(x, y)), add(dx, dy)) && "sparse add failed");
+    assert(vectors_equal(to_dense(subtract(x, y)), subtract(dx, dy)) && "sparse subtract failed");
+
+    Vector acc = dy;
+    axpy(2.0, x, acc);
+    assert(vectors_equal(acc, add(dy, scalar_multiply(2.0, dx))) && "sparse-dense axpy failed");
+    axpy(2.0, x, y);
+    assert(vectors_equal(to_dense(y), acc) && "sparse-sparse axpy failed");
+
+    // Unbalanced operands take the binary-search path
+    SparseVector wide(1000);
+    for (size_t i = 0; i < 1000; i += 3) wide.push_back(i, 1.0 + i);
+    SparseVector narrow(1000, {3, 500, 999}, {1.0, 1.0, 1.0});
+    assert(approx_equal(dot(narrow, wide), dot(to_dense(narrow), to_dense(wide))) && "galloping dot failed");
+    std::cout << "✓ SparseVector passed\n";
+}
+
+void test_sparse_matrix() {
+    std::cout << "\n--- Testing CSR/CSC matrices ---\n";
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> value(-1.0, 1.0);
+    std::uniform_int_distribution<size_t> row(0, 39), col(0, 24);
+
+    std::vector<Triplet> entries;
+    for (int k = 0; k < 120; ++k)
+        entries.push_back({row(rng), col(rng), value(rng)});   // may repeat cells
+
+    DenseMatrix expected(40, 25);
+    for (const Triplet& t : entries) expected(t.row, t.col) += t.value;
+
+    CsrMatrix A = make_csr(40, 25, entries);
+    assert(matrices_equal(to_dense(A), expected) && "make_csr failed");
+    CscMatrix C = to_csc(A);
+    assert(matrices_equal(to_dense(C), expected) && "to_csc failed");
+    assert(matrices_equal(to_dense(to_csr(C)), expected) && "to_csr(CSC) failed");
+    assert(to_csr(expected).nnz() == A.nnz() && "to_csr(dense) failed");
+
+    Vector x(25), r(40);
+    for (double& v : x) v = value(rng);
+    for (double& v : r) v = value(rng);
+    assert(vectors_equal(matvec(A, x), matvec(expected, x), 1e-12) && "CSR matvec failed");
+    assert(vectors_equal(matvec(C, x), matvec(expected, x), 1e-12) && "CSC matvec failed");
+    assert(vectors_equal(matvec_transpose(A, r), matvec(transpose(expected), r), 1e-12) && "CSR transpose matvec failed");
+
+    Vector y = r;
+    gemv(2.0, A, x, 0.5, y);
+    Vector y_dense = r;
+    gemv(2.0, expected, x, 0.5, y_dense);
+    assert(vectors_equal(y, y_dense, 1e-12) && "CSR gemv failed");
+    std::cout << "✓ CSR/CSC matrices passed\n";
+}
+
+void test_sparse_gradient() {
+    std::cout << "\n--- Testing sparse gradients ---\n";
+    SparseVector x(4, {0, 3}, {2.0, 1.0});
+    Vector theta{1.0, 5.0, 5.0, 1.0};
+    SparseVector grad = linear_gradient(x, 1.0, theta);   // error = 2
+    assert(vectors_equal(to_dense(grad), {8.0, 0.0, 0.0, 4.0}) && "sparse linear_gradient failed");
+    assert(vectors_equal(gradient_step(theta, grad, -0.5), {-3.0, 5.0, 5.0, -1.0}) && "sparse gradient_step failed");
+
+    CsrMatrix X = make_csr({x, SparseVector(4, {1}, {1.0})});
+    Vector ys{1.0, 2.0};
+    Vector expected = scalar_multiply(0.5, add(to_dense(grad), to_dense(linear_gradient(SparseVector(4, {1}, {1.0}), 2.0, theta))));
+    assert(vectors_equal(least_squares_gradient(X, ys, theta), expected) && "least_squares_gradient failed");
+    std::cout << "✓ sparse gradients passed\n";
+}
+
 int main() {
     std::cout << "=============== Linear Algebra Tests ===============\n";
     
@@ -202,11 +875,23 @@ int main() {
         test_scalar_multiply();
         test_vector_sum();
         test_vector_mean();
+        test_vector_sum_compensated();
         test_dot_product();
         test_sum_of_squares();
         test_magnitude();
         test_distance();
         test_squared_distance();
+        test_inplace_ops();
+        test_vector_expressions();
+        test_cholesky();
+        test_least_squares();
+        test_fixed_vector();
+        test_fixed_gradient();
+        test_sparse_vector();
+        test_sparse_matrix();
+        test_sparse_gradient();
+        test_simd_levels_agree();
+        test_float_kernels();
         
         // Matrix tests
         test_matrix_shape();
@@ -214,6 +899,26 @@ int main() {
         test_get_column();
         test_identity_matrix();
         test_make_matrix();
+        test_matrix_generators();
+
+        // Dense matrix tests
+        test_dense_matrix_layout();
+        test_dense_row_column_views();
+        test_dense_block_view();
+        test_dense_identity_and_conversion();
+
+        test_arena();
+
+        // Matrix products
+        test_parallel_for();
+        test_matrix_multiply();
+        test_matrix_multiply_threads();
+        test_matvec();
+        test_transpose();
+
+        // Pairwise distances
+        test_pairwise_squared_distances();
+        test_pairwise_top_k();
         
         std::cout << "\n=============== All Linear Algebra Tests PASSED ✓ ===============\n";
     } catch (const std::exception& e) {
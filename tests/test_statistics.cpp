@@ -2,8 +2,28 @@
 #include <cassert>
 #include <cmath>
 #include <algorithm>
+#include <random>
+#include <map>
 #include "ds/statistics.hpp"
 #include "ds/linear_algebra.hpp"
+#include "ds/sketches.hpp"
+#include "ds/describe.hpp"
+#include "ds/columnar.hpp"
+#include "ds/csv.hpp"
+#include "ds/histogram.hpp"
+#include "ds/rolling.hpp"
+#include "ds/bootstrap.hpp"
+#include "ds/probability.hpp"
+#include "ds/simd.hpp"
+#include <cstdint>
+#include <limits>
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <atomic>
+#include <cstdlib>
+#include <new>
 
 using namespace ds;
 
@@ -69,6 +89,35 @@ void test_quantile() {
     std::cout << "✓ quantile(0.75) = " << q75 << " (75th percentile)\n";
 }
 
+void test_quantiles() {
+    std::cout << "\n--- Testing quantiles (selection) ---\n";
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dist(-100.0, 100.0);
+    for (size_t n : {1u, 2u, 7u, 100u, 1001u}) {
+        Vector v(n);
+        for (double& x : v) x = dist(gen);
+        Vector sorted = v;
+        std::sort(sorted.begin(), sorted.end());
+
+        Vector ps{0.9, 0.0, 0.5, 0.25, 0.5, 1.0, 0.75, 0.01};
+        Vector qs = quantiles(v, ps);
+        Vector qs_sorted = quantiles(sorted, ps);      // presorted fast path
+        assert(qs.size() == ps.size() && "one result per requested point");
+        for (size_t i = 0; i < ps.size(); ++i) {
+            double expected = sorted[std::min(n - 1, static_cast<size_t>(ps[i] * n))];
+            assert(qs[i] == expected && "quantiles must match a full sort");
+            assert(qs_sorted[i] == expected && "sorted input must give the same result");
+            assert(quantile(v, ps[i]) == expected && "quantile must match a full sort");
+            assert(quantile_sorted(sorted, ps[i]) == expected && "quantile_sorted failed");
+        }
+        double med = n % 2 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0;
+        assert(median(v) == med && "median must match a full sort");
+    }
+    Vector v{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0};
+    assert(interquartile_range(v) == quantile(v, 0.75) - quantile(v, 0.25) && "IQR failed");
+    std::cout << "✓ selected quantiles/median match a full sort (unsorted and sorted input)\n";
+}
+
 void test_mode() {
     std::cout << "\n--- Testing mode ---\n";
     Vector v{1.0, 2.0, 2.0, 3.0, 3.0, 3.0, 4.0};
@@ -88,6 +137,91 @@ void test_mode_empty() {
     std::cout << "✓ mode({}) returns empty vector\n";
 }
 
+void test_mode_large() {
+    std::cout << "\n--- Testing mode (sorting and hashing paths) ---\n";
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<int> dist(0, 999);
+    for (size_t n : {1000u, 100000u}) {   // below and above the hashing threshold
+        Vector v(n);
+        for (double& x : v) x = dist(gen);
+        std::map<double, size_t> counts;
+        for (double x : v) counts[x]++;
+        size_t best = 0;
+        for (const auto& c : counts) best = std::max(best, c.second);
+        Vector expected;
+        for (const auto& c : counts)
+            if (c.second == best) expected.push_back(c.first);
+        assert(mode(v) == expected && "mode must return every most frequent value, ascending");
+    }
+    Vector zeros(5000, 1.0);
+    zeros[0] = zeros[1] = -0.0;
+    zeros[2] = 0.0;
+    assert(mode(zeros) == Vector{1.0} && "mode failed on large input");
+    assert(mode(Vector{-0.0, 0.0, 1.0}).size() == 1 && "0.0 and -0.0 are the same value");
+
+    // Every NaN is a distinct value seen once, on both paths
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    assert(mode(Vector{3, 1, nan, 2, 1, nan, 2, 3, 1, nan, 5, 1}) == Vector{1.0} && "NaN broke mode");
+    for (size_t n : {100u, 10000u}) {
+        Vector with_nans(n, nan);
+        with_nans[0] = with_nans[1] = 7.0;
+        assert(mode(with_nans) == Vector{7.0} && "repeated NaNs must not be a mode");
+        with_nans[1] = 8.0;
+        Vector all_distinct = mode(with_nans);
+        assert(all_distinct.size() == n && all_distinct[0] == 7.0 && all_distinct[1] == 8.0 &&
+               std::isnan(all_distinct.back()) && "with no repeats every value, NaNs included, is a mode");
+    }
+    assert(mode(Vector{nan, nan}).size() == 2 && "all-NaN mode failed");
+    std::cout << "✓ mode matches an ordered count for small and large inputs\n";
+}
+
+void test_heavy_hitters() {
+    std::cout << "\n--- Testing HeavyHitters / CountMinSketch ---\n";
+    // Zipf-like stream: value k occurs about n / k^1.2 times
+    std::mt19937 gen(5);
+    Vector weights(5000);
+    for (size_t k = 0; k < weights.size(); ++k) weights[k] = 1.0 / std::pow(k + 1.0, 1.2);
+    std::discrete_distribution<int> dist(weights.begin(), weights.end());
+    const size_t n = 100000;
+    Vector xs(n);
+    for (double& x : xs) x = dist(gen);
+    std::map<double, uint64_t> truth;
+    for (double x : xs) truth[x]++;
+
+    HeavyHitters whole(64), merged(64);
+    CountMinSketch cms_whole, cms_merged;
+    whole.push(ConstVectorSpan(xs));
+    cms_whole.push(ConstVectorSpan(xs));
+    for (size_t s = 0; s < 4; ++s) {
+        HeavyHitters part(64);
+        CountMinSketch cms_part;
+        ConstVectorSpan chunk(xs.data() + s * n / 4, n / 4);
+        part.push(chunk);
+        cms_part.push(chunk);
+        merged.merge(part);
+        cms_merged.merge(cms_part);
+    }
+    assert(merged.count() == n && cms_merged.count() == n && "sketch counts failed");
+
+    for (const HeavyHitters* hh : {&whole, &merged}) {
+        std::vector<HeavyHitters::Item> top = hh->top(5);
+        assert(top.size() == 5 && "top-k size failed");
+        for (size_t i = 0; i < top.size(); ++i) {
+            assert(top[i].value == double(i) && "top-k must find the most frequent values in order");
+            uint64_t t = truth[top[i].value];
+            assert(top[i].count >= t && top[i].count - top[i].error <= t && "Space-Saving bounds failed");
+            assert(top[i].error <= n / 64 && "Space-Saving error bound failed");
+        }
+        assert(hh->mode() == mode(xs) && "approximate mode failed");
+    }
+    for (const CountMinSketch* cms : {&cms_whole, &cms_merged})
+        for (const auto& t : truth) {
+            uint64_t e = cms->estimate(t.first);
+            assert(e >= t.second && e <= t.second + n / 100 && "Count-Min bounds failed");
+        }
+    std::cout << "✓ top-5 and mode found in 64 counters; Count-Min estimates within bounds\n";
+}
+
 void test_data_range() {
     std::cout << "\n--- Testing data_range ---\n";
     Vector v{1.0, 5.0, 3.0, 9.0, 2.0};
@@ -120,6 +254,31 @@ void test_variance() {
     assert(result > 0 && "variance should be positive");
 }
 
+// Counts every plain operator new in this binary, so tests can check that a
+// routine allocates nothing
+std::atomic<size_t> g_allocations{0};
+
+void* operator new(size_t size) {
+    ++g_allocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+void test_variance_allocates_nothing() {
+    std::cout << "\n--- Testing variance/covariance allocate nothing ---\n";
+    Vector x(1000), y(1000);
+    for (size_t i = 0; i < x.size(); ++i) { x[i] = i % 7; y[i] = i % 5; }
+    covariance(x, y);   // warm up
+    const size_t before = g_allocations;
+    double sink = 0.0;
+    for (int iter = 0; iter < 100; ++iter)
+        sink += variance(x) + covariance(x, y) + standard_deviation(x);
+    assert(g_allocations == before && sink > 0.0 && "variance/covariance should not allocate");
+    std::cout << "✓ variance/covariance need no heap allocations\n";
+}
+
 void test_standard_deviation() {
     std::cout << "\n--- Testing standard_deviation ---\n";
     Vector v{2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0};
@@ -166,6 +325,578 @@ void test_correlation_zero_variance() {
     std::cout << "✓ correlation with constant vector returns 0\n";
 }
 
+void test_parallel_statistics() {
+    std::cout << "\n--- Testing parallel statistics (execution::par) ---\n";
+    std::mt19937 gen(19);
+    std::normal_distribution<double> dist(1e3, 5.0);
+    const size_t n = 1000003;
+    Vector x(n), y(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = dist(gen);
+        y[i] = 0.5 * x[i] + dist(gen);
+    }
+
+    set_num_threads(4);
+    auto close = [](double a, double b) { return std::fabs(a - b) <= 1e-9 * std::fabs(b); };
+    assert(close(mean(execution::par, x), mean(x)) && "parallel mean failed");
+    assert(close(variance(execution::par, x), variance(x)) && "parallel variance failed");
+    assert(close(standard_deviation(execution::par, x), standard_deviation(x)) && "parallel std failed");
+    assert(data_range(execution::par, x) == data_range(x) && "parallel data_range failed");
+    assert(close(covariance(execution::par, x, y), covariance(x, y)) && "parallel covariance failed");
+    assert(close(correlation(execution::par, x, y), correlation(x, y)) && "parallel correlation failed");
+    // chunk means are merged stably, not summed naively
+    const Vector tenths(n, 0.1);
+    assert(std::fabs(mean(execution::par, tenths) - 0.1) < 1e-14 && "parallel mean drifts");
+    Vector d = de_mean(execution::par, x);
+    assert(d.size() == n && close(d[n / 2] + mean(execution::par, x), x[n / 2]) && "parallel de_mean failed");
+
+    // same thread count, same chunks, same bits
+    double v1 = variance(execution::par, x);
+    double c1 = covariance(execution::par, x, y);
+    for (int run = 0; run < 3; ++run)
+        assert(variance(execution::par, x) == v1 && covariance(execution::par, x, y) == c1 &&
+               "parallel results must be reproducible");
+    set_num_threads(0);
+    std::cout << "✓ parallel mean/variance/range/de_mean/covariance match serial and are reproducible\n";
+}
+
+void test_covariance_matrix() {
+    std::cout << "\n--- Testing covariance_matrix / correlation_matrix ---\n";
+    std::mt19937 gen(17);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    const size_t n = 200, k = 300;   // more columns than one block row
+    DenseMatrix X(n, k);
+    std::vector<Vector> columns(k, Vector(n));
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < k; ++j)
+            X(i, j) = columns[j][i] = j == 7 ? 2.5 : dist(gen) + (j % 3 == 0 ? X(i, 0) : 0.0) + j;
+
+    DenseMatrix C = covariance_matrix(X);
+    DenseMatrix R = correlation_matrix(X);
+    assert(C.rows() == k && C.cols() == k && "covariance_matrix shape failed");
+    for (size_t a = 0; a < k; ++a)
+        for (size_t b = 0; b < k; ++b) {
+            assert(C(a, b) == C(b, a) && R(a, b) == R(b, a) && "matrices must be symmetric");
+            if (b > a && b % 11 != 0) continue;   // spot-check the pairwise API
+            double cov = covariance(columns[a], columns[b]);
+            double cor = correlation(columns[a], columns[b]);
+            assert(std::fabs(C(a, b) - cov) < 1e-10 * (1.0 + std::fabs(cov)) && "covariance_matrix failed");
+            assert(std::fabs(R(a, b) - cor) < 1e-10 && "correlation_matrix failed");
+        }
+    assert(R(0, 0) == 1.0 && R(7, 7) == 0.0 && R(7, 0) == 0.0 && "diagonal / constant column failed");
+    std::cout << "✓ " << k << " x " << k << " covariance and correlation matrices match the pairwise functions\n";
+}
+
+void test_running_stats() {
+    std::cout << "\n--- Testing streaming accumulators ---\n";
+    std::mt19937 gen(3);
+    std::normal_distribution<double> dist(1e6, 2.0);   // large mean: cancellation-prone
+    Vector x(10000), y(10000);
+    for (size_t i = 0; i < x.size(); ++i) { x[i] = dist(gen); y[i] = 0.5 * x[i] + dist(gen); }
+
+    // One value at a time, in uneven chunks, and merged from halves all agree
+    RunningStats one, chunks, left, right;
+    for (double v : x) one.push(v);
+    for (size_t lo = 0; lo < x.size(); lo += 777)
+        chunks.push(ConstVectorSpan(x).subspan(lo, std::min<size_t>(777, x.size() - lo)));
+    left.push(ConstVectorSpan(x).subspan(0, 4000));
+    right.push(ConstVectorSpan(x).subspan(4000, 6000));
+    left.merge(right);
+
+    double m = 0.0;
+    for (double v : x) m += v;
+    m /= x.size();
+    double ss = 0.0;
+    for (double v : x) ss += (v - m) * (v - m);
+    const double expected_var = ss / (x.size() - 1);
+
+    for (const RunningStats* s : {&one, &chunks, &left}) {
+        assert(s->count() == x.size() && "accumulator count wrong");
+        assert(approx_equal(s->mean(), m, 1e-6) && "accumulator mean wrong");
+        assert(std::abs(s->variance() - expected_var) < 1e-9 * expected_var && "accumulator variance wrong");
+    }
+    assert(one.min() == *std::min_element(x.begin(), x.end()) && "accumulator min wrong");
+    assert(left.max() == *std::max_element(x.begin(), x.end()) && "accumulator max wrong");
+
+    RunningCovariance pairs, a, b;
+    for (size_t i = 0; i < x.size(); ++i) pairs.push(x[i], y[i]);
+    a.push(ConstVectorSpan(x).subspan(0, 5000), ConstVectorSpan(y).subspan(0, 5000));
+    b.push(ConstVectorSpan(x).subspan(5000, 5000), ConstVectorSpan(y).subspan(5000, 5000));
+    a.merge(b);
+    assert(approx_equal(pairs.covariance(), a.covariance(), 1e-9) && "merged covariance differs");
+    assert(approx_equal(pairs.correlation(), correlation(x, y), 1e-9) && "streamed correlation differs");
+    assert(approx_equal(a.variance_x(), expected_var, 1e-9) && "covariance accumulator variance wrong");
+    std::cout << "✓ streaming, chunked and merged accumulators agree\n";
+}
+
+void test_quantile_sketch() {
+    std::cout << "\n--- Testing QuantileSketch ---\n";
+    std::mt19937 gen(11);
+    std::lognormal_distribution<double> dist(0.0, 1.0);
+    const size_t n = 200000;
+    Vector xs(n);
+    for (double& x : xs) x = dist(gen);
+    Vector sorted = xs;
+    std::sort(sorted.begin(), sorted.end());
+
+    // One sketch per shard, merged, against one sketch of the whole stream
+    QuantileSketch whole;
+    whole.push(ConstVectorSpan(xs));
+    QuantileSketch merged;
+    const size_t shards = 4;
+    for (size_t s = 0; s < shards; ++s) {
+        QuantileSketch part;
+        for (size_t i = s * n / shards; i < (s + 1) * n / shards; ++i)
+            part.push(xs[i]);
+        merged.merge(part);
+    }
+    assert(whole.count() == n && merged.count() == n && "sketch counts failed");
+    assert(whole.retained() < 3 * 200 + 64 && "sketch memory must stay bounded");
+    assert(merged.min() == sorted.front() && merged.max() == sorted.back() && "min/max are exact");
+
+    Vector ps{0.0, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 1.0};
+    for (const QuantileSketch* sketch : {&whole, &merged}) {
+        Vector qs = sketch->quantiles(ps);
+        for (size_t i = 0; i < ps.size(); ++i) {
+            // true rank of the returned value vs the requested one
+            double true_rank = double(std::upper_bound(sorted.begin(), sorted.end(), qs[i]) - sorted.begin()) / n;
+            assert(std::fabs(true_rank - ps[i]) < 0.02 && "sketch rank error too large");
+            assert(std::fabs(sketch->rank(qs[i]) - true_rank) < 0.02 && "sketch rank() failed");
+        }
+        assert(qs[0] == sorted.front() && qs.back() == sorted.back() && "extreme quantiles are exact");
+        assert(sketch->median() == sketch->quantile(0.5) && "sketch median failed");
+    }
+    double iqr = merged.interquartile_range();
+    assert(std::fabs(iqr - interquartile_range(xs)) < 0.05 * interquartile_range(xs) && "sketch IQR failed");
+    std::cout << "✓ " << n << " values in " << whole.retained() << " retained; merged shards within 2% rank error\n";
+}
+
+void test_describe() {
+    std::cout << "\n--- Testing describe ---\n";
+    std::mt19937 gen(13);
+    std::normal_distribution<double> dist(10.0, 3.0);
+    const size_t rows = 150000, cols = 5;
+    DenseMatrix table(rows, cols);
+    std::vector<Vector> columns(cols, Vector(rows));
+    for (size_t r = 0; r < rows; ++r)
+        for (size_t c = 0; c < cols; ++c)
+            columns[c][r] = table(r, c) = dist(gen) * (c + 1);
+
+    DescribeOptions exact;
+    exact.exact_quantiles = true;
+    std::vector<std::vector<ColumnSummary>> results{
+        describe(columns), describe(columns, exact), describe(table), describe(table, exact)};
+    for (size_t c = 0; c < cols; ++c) {
+        const Vector& x = columns[c];
+        Vector q = quantiles(x, {0.25, 0.5, 0.75});
+        double spread = interquartile_range(x);
+        for (size_t i = 0; i < results.size(); ++i) {
+            const ColumnSummary& s = results[i][c];
+            assert(s.count == rows && "describe count failed");
+            assert(std::fabs(s.mean - mean(x)) < 1e-9 * std::fabs(mean(x)) && "describe mean failed");
+            assert(std::fabs(s.variance - variance(x)) < 1e-9 * variance(x) && "describe variance failed");
+            assert(s.min == *std::min_element(x.begin(), x.end()) && "describe min failed");
+            assert(s.max == *std::max_element(x.begin(), x.end()) && "describe max failed");
+            for (size_t j = 0; j < q.size(); ++j) {
+                if (i % 2 == 1) assert(s.quantiles[j] == q[j] && "exact describe quantile failed");
+                else assert(std::fabs(s.quantiles[j] - q[j]) < 0.05 * spread && "sketched describe quantile failed");
+            }
+        }
+    }
+
+    // short and empty columns
+    std::vector<ColumnSummary> small = describe(std::vector<Vector>{Vector{4.0}, Vector{}});
+    assert(small[0].count == 1 && small[0].mean == 4.0 && std::isnan(small[0].variance) && "single value failed");
+    assert(small[1].count == 0 && std::isnan(small[1].mean) && "empty column failed");
+    std::cout << "✓ describe of " << cols << " columns x " << rows
+              << " rows matches per-column statistics (spans and table, exact and sketched)\n";
+}
+
+void test_columnar_file() {
+    std::cout << "\n--- Testing columnar files ---\n";
+    std::mt19937 gen(23);
+    std::normal_distribution<double> dist(5.0, 2.0);
+    const size_t n = 100000;
+    Vector price(n), volume(n);
+    FloatVector ratio(n);
+    for (size_t i = 0; i < n; ++i) {
+        price[i] = dist(gen);
+        volume[i] = 3.0 * price[i] + dist(gen);
+        ratio[i] = static_cast<float>(price[i] / 10.0);
+    }
+
+    const std::string path = "ds_columnar_test.bin";
+    ColumnarWriter writer(4096);
+    writer.add_column("price", price);
+    writer.add_column("volume", volume);
+    writer.add_column("ratio", ConstFloatSpan(ratio));
+    writer.write(path);
+
+    {
+        ColumnarFile file(path);
+        assert(file.rows() == n && file.num_columns() == 3 && "columnar shape failed");
+        assert(file.find("volume") == 1 && file.find("missing") == 3 && "columnar find failed");
+        assert(file.type(2) == ColumnType::Float32 && "columnar type failed");
+
+        // zero-copy spans straight into the statistics and kernels
+        ConstVectorSpan p = file.column(file.find("price"));
+        ConstVectorSpan v = file.column(file.find("volume"));
+        assert(reinterpret_cast<uintptr_t>(p.data()) % 64 == 0 && "column data must be aligned");
+        assert(mean(p) == mean(price) && variance(p) == variance(price) && "span mean/variance failed");
+        assert(quantile(p, 0.9) == quantile(price, 0.9) && median(v) == median(volume) && "span quantile failed");
+        assert(correlation(p, v) == correlation(price, volume) && "span correlation failed");
+        assert(dot(p, v) == dot(price, volume) && "span dot failed");
+        assert(mean(file.float_column(2)) == mean(ConstFloatSpan(ratio)) && "float column failed");
+        size_t wrong_type = 0;
+        try { file.column(2); } catch (const std::runtime_error&) { ++wrong_type; }
+        try { file.float_column(0); } catch (const std::runtime_error&) { ++wrong_type; }
+        assert(wrong_type == 2 && "reading a column as the wrong type must throw");
+
+        Span<const ChunkStats> stats = file.chunk_stats(0);
+        assert(stats.size() == file.num_chunks() && stats.size() == (n + 4095) / 4096 && "chunk count failed");
+        double total = 0.0, lo = stats[0].min;
+        for (const ChunkStats& c : stats) {
+            total += c.sum;
+            lo = std::min(lo, c.min);
+        }
+        assert(std::fabs(total / n - mean(price)) < 1e-12 * mean(price) && "chunk sums failed");
+        assert(lo == *std::min_element(price.begin(), price.end()) && "chunk min failed");
+    }
+
+    // anything that is not a valid file is reported, not read
+    { std::ofstream junk(path, std::ios::binary); junk << "not a columnar file at all, just some text"; }
+    bool rejected = false;
+    try { ColumnarFile bad(path); } catch (const std::runtime_error&) { rejected = true; }
+    assert(rejected && "invalid file must throw");
+    std::remove(path.c_str());
+    rejected = false;
+    try { ColumnarFile missing(path); } catch (const std::runtime_error&) { rejected = true; }
+    assert(rejected && "missing file must throw");
+    std::cout << "✓ mapped columns feed mean/variance/quantile/correlation/dot without a copy\n";
+}
+
+void test_csv() {
+    std::cout << "\n--- Testing CSV ingestion ---\n";
+    CsvTable small = parse_csv("x, y ,z\r\n1,2.5,-3e2\r\n\r\n+4, ,1e-3\n5,6,7");
+    assert((small.names == std::vector<std::string>{"x", "y", "z"}) && "csv header failed");
+    assert(small.rows() == 3 && "csv row count failed");
+    assert(small.columns[0] == (Vector{1.0, 4.0, 5.0}) && "csv column failed");
+    assert(small.columns[2] == (Vector{-300.0, 1e-3, 7.0}) && "csv exponent parsing failed");
+    assert(std::isnan(small.columns[1][1]) && "empty field must be NaN");
+
+    CsvOptions no_header;
+    no_header.header = false;
+    no_header.delimiter = ';';
+    CsvTable plain = parse_csv("1;2\n3;4\n", no_header);
+    assert(plain.names.size() == 2 && plain.rows() == 2 && plain.columns[1][1] == 4.0 && "headerless csv failed");
+
+    for (const char* bad : {"a,b\n1,2\n3\n", "a,b\n1,2,3\n", "a,b\n1,x\n"}) {
+        bool rejected = false;
+        try { parse_csv(bad); } catch (const std::runtime_error&) { rejected = true; }
+        assert(rejected && "malformed csv must throw");
+    }
+
+    // Large input: parallel pieces must stitch rows back in order
+    std::mt19937 gen(29);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    const size_t n = 200000;
+    Vector a(n), b(n);
+    std::string text = "a,b\n";
+    char field[64];
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = static_cast<double>(i);
+        b[i] = dist(gen);
+        auto end = std::to_chars(field, field + sizeof field, b[i]).ptr;   // shortest round-trip form
+        text += std::to_string(i) + "," + std::string(field, end) + "\n";
+    }
+    set_num_threads(4);
+    CsvTable big = parse_csv(text);
+    assert(big.rows() == n && big.columns[0] == a && big.columns[1] == b && "parallel csv parse failed");
+
+    // Streamed in small chunks into the accumulators
+    const std::string path = "ds_csv_test.csv";
+    { std::ofstream out(path, std::ios::binary); out << text; }
+    CsvOptions streaming;
+    streaming.chunk_bytes = 1 << 16;
+    CsvReader reader(path, streaming);
+    std::vector<RunningStats> stats(reader.names().size());
+    std::vector<Vector> chunk;
+    size_t chunks = 0;
+    while (reader.next(chunk)) {
+        for (size_t c = 0; c < chunk.size(); ++c) stats[c].push(chunk[c]);
+        ++chunks;
+    }
+    set_num_threads(0);
+    assert(chunks > 1 && stats[1].count() == n && "streaming csv lost rows");
+    assert(std::fabs(stats[1].mean() - mean(b)) < 1e-9 && stats[0].max() == n - 1.0 && "streaming csv stats failed");
+    assert(read_csv(path).columns[1] == b && "read_csv failed");
+
+    // Blank lines before a header that spans several tiny reads
+    { std::ofstream out(path, std::ios::binary); out << "\n  \r\nalpha,beta,gamma\n1,2,3\n4,5,6\n"; }
+    CsvOptions tiny;
+    tiny.chunk_bytes = 4;
+    CsvReader split(path, tiny);
+    assert((split.names() == std::vector<std::string>{"alpha", "beta", "gamma"}) && "split header truncated");
+    Vector gamma;
+    while (split.next(chunk))
+        gamma.insert(gamma.end(), chunk[2].begin(), chunk[2].end());
+    assert((gamma == Vector{3, 6}) && "tiny-chunk csv rows failed");
+    std::remove(path.c_str());
+    std::cout << "✓ " << n << " rows parsed in parallel and streamed in " << chunks << " chunks\n";
+}
+
+void test_histogram() {
+    std::cout << "\n--- Testing Histogram ---\n";
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    Histogram h = Histogram::uniform(0.0, 10.0, 10);
+    h.add(Vector{0.0, 0.5, 9.99, 10.0, 5.0, -1.0, 11.0, nan});
+    assert(h.count(0) == 2 && h.count(5) == 1 && h.count(9) == 2 && "uniform bins failed (hi is in the last bin)");
+    assert(h.underflow() == 1 && h.overflow() == 1 && h.missing() == 1 && h.total() == 5 && "out-of-range counts failed");
+    assert(h.bin_of(3.7) == 3 && h.bin_of(-0.1) == 10 && "bin_of failed");
+
+    // every edge lands in the bin it opens, even where the rounded edge and
+    // the bin arithmetic disagree (e.g. uniform(0, 1, 100) edge 29)
+    for (size_t bins : {3, 7, 13, 100, 1000})
+        for (double hi : {1.0, 3.0, 1000.0})
+            for (const Histogram& g : {Histogram::uniform(0.0, hi, bins), Histogram::uniform(-hi, 0.1, bins),
+                                       Histogram::log_scale(1.0, 1.0 + hi, bins)}) {
+                for (size_t i = 0; i < bins; ++i)
+                    assert(g.bin_of(g.edges()[i]) == i && "an edge must open its own bin");
+                assert(g.bin_of(g.edges()[bins]) == bins - 1 && "the upper edge belongs to the last bin");
+                Histogram edges_only = g;
+                edges_only.add(g.edges());
+                for (size_t i = 0; i < bins; ++i)
+                    assert(edges_only.count(i) == (i + 1 == bins ? 2 : 1) && "edges binned wrongly in bulk");
+            }
+
+    Histogram lg = Histogram::log_scale(1.0, 1000.0, 3);
+    lg.add(Vector{1.0, 5.0, 10.5, 99.0, 150.0, 1000.0, 0.0, -5.0, 2000.0});
+    assert((lg.counts() == Vector{2.0, 2.0, 2.0}) && lg.underflow() == 2 && lg.overflow() == 1 && "log bins failed");
+
+    Histogram edges = Histogram::with_edges({0.0, 1.0, 5.0, 6.0});
+    edges.add(Vector{0.0, 0.99, 1.0, 4.0, 5.0, 6.0, 6.5, nan}, Vector{1, 1, 2, 2, 3, 4, 5, 6});
+    assert((edges.counts() == Vector{2.0, 4.0, 7.0}) && edges.overflow() == 5 && edges.missing() == 6 && "weighted edge bins failed");
+
+    // Every SIMD level bins identically, and serial == parallel == merged halves
+    std::mt19937 gen(31);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    const size_t n = 300001;
+    Vector xs(n);
+    for (double& x : xs) x = dist(gen);
+    xs[17] = nan;
+    xs[18] = 4.0;
+    const SimdLevel original = simd_level();
+    Histogram reference = Histogram::uniform(-4.0, 4.0, 40);
+    set_simd_level(SimdLevel::Scalar);
+    reference.add(xs);
+    for (int l = 0; l <= static_cast<int>(detected_simd_level()); ++l) {
+        set_simd_level(static_cast<SimdLevel>(l));
+        Histogram at_level = Histogram::uniform(-4.0, 4.0, 40);
+        at_level.add(xs);
+        assert(at_level.counts() == reference.counts() && at_level.missing() == 1 && "SIMD levels disagree");
+    }
+    set_simd_level(original);
+
+    set_num_threads(4);
+    Histogram parallel = Histogram::uniform(-4.0, 4.0, 40);
+    parallel.add(execution::par, xs);
+    set_num_threads(0);
+    Histogram merged = Histogram::uniform(-4.0, 4.0, 40), half = Histogram::uniform(-4.0, 4.0, 40);
+    merged.add(ConstVectorSpan(xs).subspan(0, n / 2));
+    half.add(ConstVectorSpan(xs).subspan(n / 2, n - n / 2));
+    merged.merge(half);
+    assert(parallel.counts() == reference.counts() && merged.counts() == reference.counts() && "parallel/merged counts failed");
+    assert(reference.total() + reference.underflow() + reference.overflow() + reference.missing() == n && "values lost");
+
+    // density matches the normal pdf it was drawn from
+    Vector density = reference.density(), centers = reference.centers();
+    for (size_t i = 0; i < density.size(); ++i)
+        assert(std::fabs(density[i] - normal_pdf(centers[i])) < 0.01 && "density failed");
+
+    Histogram eq = Histogram::quantile_bins(xs, 8);
+    eq.add(xs);
+    for (size_t i = 0; i < eq.bins(); ++i)
+        assert(std::fabs(eq.count(i) - n / 8.0) < 2 && "quantile bins must be equally full");
+    std::cout << "✓ uniform/log/edge/quantile bins, weights, SIMD levels, parallel and merged counts agree\n";
+}
+
+void test_rolling_windows() {
+    std::cout << "\n--- Testing rolling windows ---\n";
+    std::mt19937 gen(37);
+    std::normal_distribution<double> dist(1e6, 10.0);   // large offset: drift would show
+    const size_t n = 5000, w = 50;
+    Vector xs(n), ys(n);
+    for (size_t i = 0; i < n; ++i) {
+        xs[i] = dist(gen);
+        ys[i] = 0.3 * xs[i] + dist(gen);
+    }
+    xs[100] = xs[101] = xs[102];   // ties for the median sets
+
+    Vector means = rolling_mean(xs, w), vars = rolling_variance(xs, w);
+    Vector medians = rolling_median(xs, w), q90 = rolling_quantile(xs, w, 0.9);
+    assert(means.size() == n - w + 1 && medians.size() == n - w + 1 && "rolling result length failed");
+    RollingCovariance cov(Window::last(w));
+    for (size_t i = 0; i < n; ++i) {
+        cov.push(xs[i], ys[i]);
+        if (i + 1 < w) continue;
+        const size_t start = i + 1 - w;
+        Vector win(xs.begin() + start, xs.begin() + i + 1), win_y(ys.begin() + start, ys.begin() + i + 1);
+        assert(std::fabs(means[start] - mean(win)) < 1e-9 * 1e6 && "rolling mean failed");
+        assert(std::fabs(vars[start] - variance(win)) < 1e-6 * variance(win) && "rolling variance failed");
+        assert(medians[start] == median(win) && "rolling median failed");
+        assert(q90[start] == quantile(win, 0.9) && "rolling quantile failed");
+        assert(std::fabs(cov.covariance() - covariance(win, win_y)) < 1e-6 * std::fabs(covariance(win, win_y)) + 1e-6 &&
+               "rolling covariance failed");
+        assert(std::fabs(cov.correlation() - correlation(win, win_y)) < 1e-6 && "rolling correlation failed");
+    }
+
+    // Time windows: irregular timestamps, values within 5 time units
+    RollingStats recent(Window::within(5.0));
+    RollingQuantile recent_median(Window::within(5.0));
+    std::exponential_distribution<double> gap(1.0);
+    Vector times, values;
+    double t = 0.0;
+    for (size_t i = 0; i < 2000; ++i) {
+        t += gap(gen);
+        times.push_back(t);
+        values.push_back(xs[i]);
+        recent.push(t, xs[i]);
+        recent_median.push(t, xs[i]);
+        Vector win;
+        for (size_t j = 0; j < times.size(); ++j)
+            if (times[j] > t - 5.0) win.push_back(values[j]);
+        assert(recent.count() == win.size() && recent_median.count() == win.size() && "time window size failed");
+        assert(std::fabs(recent.mean() - mean(win)) < 1e-9 * 1e6 && "time window mean failed");
+        assert(recent_median.median() == median(win) && "time window median failed");
+        if (win.size() >= 2)
+            assert(std::fabs(recent.variance() - variance(win)) < 1e-6 * variance(win) + 1e-9 && "time window variance failed");
+    }
+
+    // A NaN or infinity stops affecting the result the moment it leaves
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    RollingStats last10(Window::last(10));
+    RollingCovariance pairs10(Window::last(10));
+    for (size_t i = 0; i < 30; ++i) {
+        const double x = i == 0 ? nan : i == 12 ? inf : double(i);
+        last10.push(x);
+        pairs10.push(double(i), x);
+        const bool poisoned = i < 10 || (i >= 12 && i < 22);
+        assert(std::isfinite(last10.mean()) != poisoned && "non-finite value must leave with its window");
+        assert(std::isfinite(pairs10.mean_y()) != poisoned && "non-finite pair must leave with its window");
+        assert((i == 0 || std::isfinite(pairs10.covariance()) != poisoned) && "non-finite pair must leave with its window");
+        if (!poisoned)
+            assert(std::fabs(last10.mean() - (double(i) - 4.5)) < 1e-9 &&
+                   std::fabs(last10.variance() - 55.0 / 6.0) < 1e-9 &&
+                   "stats after a non-finite value left are wrong");
+    }
+
+    // NaNs are counted, not ordered: the quantile is NaN while one is inside
+    Vector med = rolling_median(Vector{1, 2, nan, 4, 5, 6, 7, 8}, 3);
+    assert(med.size() == 6 && std::isnan(med[0]) && std::isnan(med[2]) &&
+           med[3] == 5 && med[5] == 7 && "rolling median with NaN failed");
+    RollingQuantile nan_only(Window::last(2), 0.9);
+    nan_only.push(nan);
+    nan_only.push(nan);
+    assert(std::isnan(nan_only.quantile()) && "all-NaN window failed");
+    nan_only.push(3.0);
+    nan_only.push(1.0);
+    assert(nan_only.quantile() == 3.0 && "quantile after NaNs left failed");
+    std::cout << "✓ count and time windows match recomputed mean/variance/median/quantile/covariance\n";
+}
+
+void test_bootstrap() {
+    std::cout << "\n--- Testing bootstrap confidence intervals ---\n";
+    std::mt19937 gen(25);
+    std::normal_distribution<double> dist(10.0, 2.0);
+    const size_t n = 2000;
+    Vector x(n), y(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = dist(gen);
+        y[i] = 0.6 * x[i] + dist(gen);
+    }
+
+    BootstrapOptions options;
+    options.resamples = 2000;
+
+    // the mean's interval is close to the normal-theory one
+    ConfidenceInterval ci = bootstrap_mean(x, options);
+    const double half = 1.96 * standard_deviation(x) / std::sqrt(double(n));
+    assert(ci.estimate == mean(x) && "bootstrap estimate must be the sample mean");
+    assert(ci.lower < ci.estimate && ci.estimate < ci.upper && "interval must contain the estimate");
+    assert(std::fabs((ci.upper - ci.lower) / (2 * half) - 1.0) < 0.1 && "mean interval width off");
+
+    // the replicates do not depend on the thread count
+    set_num_threads(4);
+    ConfidenceInterval parallel = bootstrap_mean(x, options);
+    set_num_threads(1);
+    ConfidenceInterval serial = bootstrap_mean(x, options);
+    set_num_threads(0);
+    assert(parallel.lower == serial.lower && parallel.upper == serial.upper &&
+           "bootstrap must be reproducible across thread counts");
+
+    // a replicate with every observation once is the sample statistic
+    options.method = IntervalMethod::BCa;
+    for (ConfidenceInterval c : {bootstrap_median(x, options),
+                                 bootstrap_standard_deviation(x, options),
+                                 bootstrap_correlation(x, y, options)})
+        assert(c.lower < c.estimate && c.estimate < c.upper && "BCa interval must contain the estimate");
+    assert(bootstrap_median(x, options).estimate == median(x) && "median estimate failed");
+    assert(std::fabs(bootstrap_standard_deviation(x, options).estimate - standard_deviation(x)) < 1e-12 &&
+           "standard deviation estimate failed");
+    ConfidenceInterval r = bootstrap_correlation(x, y, options);
+    assert(std::fabs(r.estimate - correlation(x, y)) < 1e-12 && "correlation estimate failed");
+    assert(r.lower > 0.45 && r.upper < 0.65 && "correlation interval failed");
+
+    // a user statistic over resample counts: the 90th percentile
+    Vector sorted = x;
+    std::sort(sorted.begin(), sorted.end());
+    options.resamples = 500;
+    ConfidenceInterval p90 = bootstrap(n, [&sorted](ResampleCounts counts) {
+        const size_t rank = static_cast<size_t>(0.9 * sorted.size());
+        size_t seen = 0, i = 0;
+        while ((seen += counts[i]) <= rank) ++i;
+        return sorted[i];
+    }, options);
+    assert(p90.estimate == quantile(x, 0.9) && p90.lower <= p90.estimate && p90.estimate <= p90.upper &&
+           "custom statistic failed");
+    std::cout << "✓ percentile/BCa intervals for mean, median, std, correlation and custom statistics\n";
+}
+
+void test_float_statistics() {
+    std::cout << "\n--- Testing statistics on float data ---\n";
+    FloatVector xf{1.5f, 2.25f, -3.0f, 4.0f, 0.5f, 7.75f};
+    FloatVector yf{2.0f, 1.0f, -1.0f, 3.5f, 0.0f, 6.0f};
+    Vector x(xf.begin(), xf.end()), y(yf.begin(), yf.end());
+
+    assert(approx_equal(mean(xf), mean(x), 1e-12) && "float mean differs from double");
+    assert(approx_equal(variance(xf), variance(x), 1e-12) && "float variance differs from double");
+    assert(approx_equal(covariance(xf, yf), covariance(x, y), 1e-12) && "float covariance differs from double");
+    assert(approx_equal(correlation(xf, yf), correlation(x, y), 1e-12) && "float correlation differs from double");
+
+    // Double accumulation: a float running sum would drift far from 0.1 here
+    FloatVector many(1 << 20, 0.1f);
+    assert(approx_equal(mean(many), double(0.1f), 1e-12) && "float mean lost precision");
+    std::cout << "✓ float mean/variance/covariance/correlation accumulate in double\n";
+}
+
+void test_sparse_statistics() {
+    std::cout << "\n--- Testing statistics on sparse data ---\n";
+    Vector x{0.0, 3.0, 0.0, 0.0, -1.0, 0.0, 2.0, 0.0};
+    Vector y{1.0, 0.0, 0.0, 0.0, 4.0, 0.0, 2.0, 0.0};
+    SparseVector sx = to_sparse(x), sy = to_sparse(y);
+
+    assert(approx_equal(mean(sx), mean(x)) && "sparse mean differs from dense");
+    assert(approx_equal(variance(sx), variance(x)) && "sparse variance differs from dense");
+    assert(approx_equal(covariance(sx, sy), covariance(x, y)) && "sparse covariance differs from dense");
+    assert(approx_equal(correlation(sx, sy), correlation(x, y)) && "sparse correlation differs from dense");
+
+    // Columns of a CSC matrix are sparse views
+    CscMatrix features = to_csc(make_csr({sx, sy}));
+    assert(approx_equal(mean(features.column(1)), 3.0 / 2.0) && "column mean failed");
+    std::cout << "✓ sparse mean/variance/covariance/correlation match dense results\n";
+}
+
 int main() {
     std::cout << "=============== Statistics Tests ===============\n";
     
@@ -174,16 +905,32 @@ int main() {
         test_median_odd();
         test_median_even();
         test_quantile();
+        test_quantiles();
         test_mode();
         test_mode_empty();
+        test_mode_large();
         test_data_range();
         test_de_mean();
         test_variance();
+        test_variance_allocates_nothing();
         test_standard_deviation();
         test_interquartile_range();
         test_covariance();
         test_correlation();
         test_correlation_zero_variance();
+        test_parallel_statistics();
+        test_covariance_matrix();
+        test_running_stats();
+        test_quantile_sketch();
+        test_heavy_hitters();
+        test_describe();
+        test_columnar_file();
+        test_csv();
+        test_histogram();
+        test_rolling_windows();
+        test_bootstrap();
+        test_float_statistics();
+        test_sparse_statistics();
         
         std::cout << "\n=============== All Statistics Tests PASSED ✓ ===============\n";
     } catch (const std::exception& e) {